@@ -0,0 +1,231 @@
+#ifndef RAPIDCSV_COLUMN_CONVERTER_HPP
+#define RAPIDCSV_COLUMN_CONVERTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "detail/convert/number_parser.hpp"
+#include "detail/convert/date_time.hpp"
+#include "detail/reader/field_view.hpp"
+
+namespace rapidcsv {
+    namespace convert {
+
+        // One bit per cell of a converted column, set for the cells that don't hold a number of the type
+        class FailureBitmap {
+            std::vector<std::uint64_t> _words;
+            std::size_t _size;
+
+        public:
+            explicit FailureBitmap(std::size_t size = 0) : _words((size + 63) / 64, 0), _size(size) {}
+
+            void reset(std::size_t size) {
+                _words.assign((size + 63) / 64, 0);
+                _size = size;
+            }
+
+            void set(std::size_t cell) {
+                _words[cell / 64] |= std::uint64_t(1) << (cell % 64);
+            }
+
+            void clear(std::size_t cell) {
+                _words[cell / 64] &= ~(std::uint64_t(1) << (cell % 64));
+            }
+
+            bool test(std::size_t cell) const {
+                return (_words[cell / 64] >> (cell % 64)) & 1;
+            }
+
+            // Number of cells covered
+            std::size_t size() const {
+                return _size;
+            }
+
+            // Number of failed cells
+            std::size_t count() const {
+                std::size_t failed = 0;
+                for (std::uint64_t word : _words) {
+                    for (; word != 0; word &= word - 1) {
+                        ++failed;
+                    }
+                }
+                return failed;
+            }
+
+            bool any() const {
+                for (std::uint64_t word : _words) {
+                    if (word != 0) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            const std::vector<std::uint64_t> &words() const {
+                return _words;
+            }
+        };
+
+        // Types convert_column() handles
+        template <typename T>
+        struct is_batch_convertible : std::integral_constant<bool,
+                (std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value &&
+                 !std::is_same<T, signed char>::value && !std::is_same<T, unsigned char>::value) ||
+                std::is_same<T, double>::value || std::is_same<T, float>::value || is_date_time<T>::value> {};
+
+        namespace number {
+            // Eight digits are checked and combined at once in a uint64 (SWAR), the first byte in the low byte
+            inline std::uint64_t load_eight(const char *at) {
+                std::uint64_t chunk;
+                std::memcpy(&chunk, at, sizeof(chunk));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                chunk = __builtin_bswap64(chunk);
+#endif
+                return chunk;
+            }
+
+            inline bool is_eight_digits(std::uint64_t chunk) {
+                // '0'..'9' are 0x30..0x39: the high nibble is 3, and adding 6 doesn't carry into it
+                return ((chunk & 0xF0F0F0F0F0F0F0F0u) |
+                        (((chunk + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4)) == 0x3333333333333333u;
+            }
+
+            inline std::uint32_t parse_eight_digits(std::uint64_t chunk) {
+                // Pairs, then groups of four, then the eight digits
+                chunk -= 0x3030303030303030u;
+                chunk = chunk * 10 + (chunk >> 8);
+                chunk = ((chunk & 0x000000FF000000FFu) * 0x000F424000000064u +
+                         ((chunk >> 16) & 0x000000FF000000FFu) * 0x0000271000000001u) >> 32;
+                return static_cast<std::uint32_t>(chunk);
+            }
+
+            // Appends the digits at the start of [first, last) to `value` and returns where they end. Only
+            // the last 19 or fewer digits are meaningful, longer runs wrap around
+            inline const char *read_digits(const char *first, const char *last, std::uint64_t &value) {
+                while (last - first >= 8) {
+                    const std::uint64_t chunk = load_eight(first);
+                    if (!is_eight_digits(chunk)) {
+                        break;
+                    }
+                    value = value * 100000000 + parse_eight_digits(chunk);
+                    first += 8;
+                }
+                for (; first != last && is_digit(*first); ++first) {
+                    value = value * 10 + static_cast<unsigned>(*first - '0');
+                }
+                return first;
+            }
+
+            inline bool is_blank(const char *first, const char *last) {
+                return skip_space(first, last) == last;
+            }
+
+            // Cells the fast paths don't take: surrounding spaces, exponents, overflow and non-numbers
+            template <typename T, typename std::enable_if<std::is_integral<T>::value>::type * = nullptr>
+            bool convert_slow(const char *first, const char *last, T &value) {
+                const ParseResult result = parse_integer(skip_space(first, last), last, value);
+                return result.ok() && is_blank(result.end, last);
+            }
+
+            template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+            bool convert_slow(const char *first, const char *last, T &value) {
+                const ParseResult result = parse_float(skip_space(first, last), last, value);
+                return result.ok() && is_blank(result.end, last);
+            }
+
+            // An optionally signed run of at most 19 digits filling the cell
+            template <typename T, typename std::enable_if<std::is_integral<T>::value>::type * = nullptr>
+            bool convert_cell(const char *first, const char *last, T &value) {
+                const char *at = first;
+                const bool negative = at != last && *at == '-';
+                if (at != last && (*at == '-' || *at == '+')) {
+                    ++at;
+                }
+
+                std::uint64_t magnitude = 0;
+                const char *end = read_digits(at, last, magnitude);
+                const std::uint64_t limit = !negative ? static_cast<std::uint64_t>(std::numeric_limits<T>::max())
+                        : std::is_signed<T>::value ? static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + 1
+                        : 0;
+                if (end != last || end == at || end - at > 19 || magnitude > limit) {
+                    return convert_slow(first, last, value);
+                }
+                value = negative && magnitude != 0 ? static_cast<T>(-static_cast<long long>(magnitude - 1) - 1)
+                                                   : static_cast<T>(magnitude);
+                return true;
+            }
+
+            // A fixed point decimal filling the cell, exact when Clinger's fast path applies
+            template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type * = nullptr>
+            bool convert_cell(const char *first, const char *last, T &value) {
+                using Format = FloatFormat<T>;
+
+                const char *at = first;
+                const bool negative = at != last && *at == '-';
+                if (at != last && (*at == '-' || *at == '+')) {
+                    ++at;
+                }
+
+                std::uint64_t mantissa = 0;
+                const char *end = read_digits(at, last, mantissa);
+                std::ptrdiff_t digits = end - at, decimals = 0;
+                if (end != last && *end == '.') {
+                    const char *fraction = end + 1;
+                    end = read_digits(fraction, last, mantissa);
+                    decimals = end - fraction;
+                    digits += decimals;
+                }
+                if (end != last || digits == 0 || digits > 19 || mantissa > Format::maxFastMantissa ||
+                    decimals > Format::maxFastExponent) {
+                    return convert_slow(first, last, value);
+                }
+                const T result = static_cast<T>(mantissa) / Format::power(static_cast<int>(decimals));
+                value = negative ? -result : result;
+                return true;
+            }
+
+            // Fixed width, read field by field from known offsets
+            template <DateFormat F>
+            bool convert_cell(const char *first, const char *last, FormattedDate<F> &value) {
+                const ParseResult result = parse_date(skip_space(first, last), last, value);
+                return result.ok() && is_blank(result.end, last);
+            }
+
+            inline bool convert_cell(const char *first, const char *last, Timestamp &value) {
+                const ParseResult result = parse_timestamp(skip_space(first, last), last, value);
+                return result.ok() && is_blank(result.end, last);
+            }
+        }
+
+        // Converts a column of raw cells into numbers in one pass: the result is sized once, and cells
+        // made of plain digits, or digits around a decimal point, are parsed eight digits at a time.
+        // Other cells go through parse_integer() or parse_float(); spaces around the number are allowed.
+        // Dates and timestamps are read from their fixed width layouts, see parse_date().
+        // Failed cells are flagged in `failures` and hold what convert_to_val() would give for them
+        template <typename T, typename std::enable_if<is_batch_convertible<T>::value>::type * = nullptr>
+        std::vector<T> convert_column(const read::FieldView *first, const read::FieldView *last,
+                                      FailureBitmap &failures) {
+            const auto size = static_cast<std::size_t>(last - first);
+            std::vector<T> column(size);
+            failures.reset(size);
+
+            T *out = column.data();
+            for (std::size_t cell = 0; cell < size; ++cell) {
+                if (!number::convert_cell(first[cell].begin(), first[cell].end(), out[cell])) {
+                    failures.set(cell);
+                }
+            }
+            return column;
+        }
+
+        template <typename T, typename std::enable_if<is_batch_convertible<T>::value>::type * = nullptr>
+        std::vector<T> convert_column(const std::vector<read::FieldView> &cells, FailureBitmap &failures) {
+            return convert_column<T>(cells.data(), cells.data() + cells.size(), failures);
+        }
+    }
+}
+
+#endif //RAPIDCSV_COLUMN_CONVERTER_HPP
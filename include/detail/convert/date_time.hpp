@@ -0,0 +1,308 @@
+#ifndef RAPIDCSV_DATE_TIME_HPP
+#define RAPIDCSV_DATE_TIME_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "detail/convert/number_parser.hpp"
+#include "detail/convert/number_formatter.hpp"
+
+namespace rapidcsv {
+    namespace convert {
+
+        // Fixed width layouts of a date
+        enum class DateFormat {
+            ISO,        // YYYY-MM-DD
+            COMPACT,    // YYYYMMDD
+            US,         // MM/DD/YYYY
+            EUROPEAN    // DD.MM.YYYY
+        };
+
+        // Days since 1970-01-01, read and written in the layout F. GetColumn<FormattedDate<F>> and
+        // GetCell<FormattedDate<F>> pick the layout through the type
+        template <DateFormat F>
+        struct FormattedDate {
+            std::int64_t days;
+
+            FormattedDate() : days(0) {}
+            explicit FormattedDate(std::int64_t pDays) : days(pDays) {}
+        };
+
+        using Date = FormattedDate<DateFormat::ISO>;
+
+        template <DateFormat F>
+        bool operator == (const FormattedDate<F> &lhs, const FormattedDate<F> &rhs) {
+            return lhs.days == rhs.days;
+        }
+
+        template <DateFormat F>
+        bool operator != (const FormattedDate<F> &lhs, const FormattedDate<F> &rhs) {
+            return lhs.days != rhs.days;
+        }
+
+        template <DateFormat F>
+        bool operator < (const FormattedDate<F> &lhs, const FormattedDate<F> &rhs) {
+            return lhs.days < rhs.days;
+        }
+
+        // Seconds since 1970-01-01T00:00:00Z
+        struct Timestamp {
+            std::int64_t seconds;
+
+            Timestamp() : seconds(0) {}
+            explicit Timestamp(std::int64_t pSeconds) : seconds(pSeconds) {}
+        };
+
+        inline bool operator == (const Timestamp &lhs, const Timestamp &rhs) {
+            return lhs.seconds == rhs.seconds;
+        }
+
+        inline bool operator != (const Timestamp &lhs, const Timestamp &rhs) {
+            return lhs.seconds != rhs.seconds;
+        }
+
+        inline bool operator < (const Timestamp &lhs, const Timestamp &rhs) {
+            return lhs.seconds < rhs.seconds;
+        }
+
+        template <typename T>
+        struct is_date_time : std::false_type {};
+
+        template <DateFormat F>
+        struct is_date_time<FormattedDate<F>> : std::true_type {};
+
+        template <>
+        struct is_date_time<Timestamp> : std::true_type {};
+
+        namespace date {
+            static constexpr std::int64_t secondsPerDay = 86400;
+
+            // Proleptic Gregorian calendar, after Howard Hinnant's days_from_civil
+            inline std::int64_t days_from_civil(std::int64_t year, unsigned month, unsigned day) {
+                year -= month <= 2 ? 1 : 0;
+                const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+                const auto yearOfEra = static_cast<unsigned>(year - era * 400);
+                const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+                const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+                return era * 146097 + static_cast<std::int64_t>(dayOfEra) - 719468;
+            }
+
+            inline void civil_from_days(std::int64_t days, std::int64_t &year, unsigned &month, unsigned &day) {
+                days += 719468;
+                const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+                const auto dayOfEra = static_cast<unsigned>(days - era * 146097);
+                const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+                const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+                const unsigned monthIndex = (5 * dayOfYear + 2) / 153;
+                day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+                month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+                year = static_cast<std::int64_t>(yearOfEra) + era * 400 + (month <= 2 ? 1 : 0);
+            }
+
+            inline unsigned days_in_month(std::int64_t year, unsigned month) {
+                static constexpr unsigned days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+                const bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+                return month == 2 && leap ? 29 : days[month - 1];
+            }
+
+            // `count` digits at `at`, false when one isn't a digit
+            inline bool read_fixed(const char *at, int count, unsigned &value) {
+                value = 0;
+                for (int digit = 0; digit < count; ++digit) {
+                    if (!number::is_digit(at[digit])) {
+                        return false;
+                    }
+                    value = value * 10 + static_cast<unsigned>(at[digit] - '0');
+                }
+                return true;
+            }
+
+            inline bool is_separator(char c) {
+                return c == '-' || c == '/' || c == '.';
+            }
+
+            // Where the fields of a layout start, and how long it is
+            struct Layout {
+                int year, month, day, length;
+            };
+
+            inline Layout layout(DateFormat format) {
+                switch (format) {
+                    case DateFormat::COMPACT:
+                        return Layout{0, 4, 6, 8};
+                    case DateFormat::US:
+                        return Layout{6, 0, 3, 10};
+                    case DateFormat::EUROPEAN:
+                        return Layout{6, 3, 0, 10};
+                    default:
+                        return Layout{0, 5, 8, 10};
+                }
+            }
+
+            // The separators sit between the fields: '-' for ISO, any one of '-', '/' and '.' otherwise
+            inline bool separators(DateFormat format, const char *at) {
+                switch (format) {
+                    case DateFormat::COMPACT:
+                        return true;
+                    case DateFormat::ISO:
+                        return at[4] == '-' && at[7] == '-';
+                    default:
+                        return is_separator(at[2]) && at[5] == at[2];
+                }
+            }
+
+            inline char *write_fixed(char *first, unsigned value, int count) {
+                for (int digit = count - 1; digit >= 0; --digit) {
+                    first[digit] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                }
+                return first + count;
+            }
+        }
+
+        // Parses a date in the layout F at the start of [first, last), checking the day against the month.
+        // Never throws, `value` is only set on success
+        template <DateFormat F>
+        ParseResult parse_date(const char *first, const char *last, FormattedDate<F> &value) {
+            const date::Layout layout = date::layout(F);
+            if (last - first < layout.length || !date::separators(F, first)) {
+                return ParseResult{first, ConvertError::INVALID};
+            }
+
+            unsigned year, month, day;
+            if (!date::read_fixed(first + layout.year, 4, year) || !date::read_fixed(first + layout.month, 2, month) ||
+                !date::read_fixed(first + layout.day, 2, day) || month < 1 || month > 12 || day < 1 ||
+                day > date::days_in_month(year, month)) {
+                return ParseResult{first, ConvertError::INVALID};
+            }
+            value.days = date::days_from_civil(year, month, day);
+            return ParseResult{first + layout.length, ConvertError::NONE};
+        }
+
+        // Parses an ISO 8601 date and time, YYYY-MM-DD[(T| )HH:MM[:SS[.fraction]][Z|(+|-)HH[[:]MM]]], at the
+        // start of [first, last). A date alone is midnight, times without an offset are taken as UTC and
+        // fractions of a second are dropped
+        inline ParseResult parse_timestamp(const char *first, const char *last, Timestamp &value) {
+            Date day;
+            ParseResult result = parse_date(first, last, day);
+            if (!result.ok()) {
+                return result;
+            }
+
+            const char *at = result.end;
+            std::int64_t seconds = day.days * date::secondsPerDay;
+            if (last - at >= 6 && (*at == 'T' || *at == 't' || *at == ' ') && at[3] == ':') {
+                unsigned hours, minutes, secs = 0;
+                if (!date::read_fixed(at + 1, 2, hours) || !date::read_fixed(at + 4, 2, minutes) ||
+                    hours > 23 || minutes > 59) {
+                    return ParseResult{first, ConvertError::INVALID};
+                }
+                at += 6;
+                if (last - at >= 3 && *at == ':') {
+                    // 60 is a leap second
+                    if (!date::read_fixed(at + 1, 2, secs) || secs > 60) {
+                        return ParseResult{first, ConvertError::INVALID};
+                    }
+                    at += 3;
+                    if (at != last && *at == '.' && at + 1 != last && number::is_digit(at[1])) {
+                        for (++at; at != last && number::is_digit(*at); ++at) {}
+                    }
+                }
+                seconds += hours * 3600 + minutes * 60 + secs;
+
+                if (at != last && (*at == 'Z' || *at == 'z')) {
+                    ++at;
+                } else if (last - at >= 3 && (*at == '+' || *at == '-')) {
+                    unsigned offsetHours, offsetMinutes = 0;
+                    if (!date::read_fixed(at + 1, 2, offsetHours) || offsetHours > 23) {
+                        return ParseResult{first, ConvertError::INVALID};
+                    }
+                    const char *offsetEnd = at + 3;
+                    const char *minutesAt = offsetEnd != last && *offsetEnd == ':' ? offsetEnd + 1 : offsetEnd;
+                    if (last - minutesAt >= 2 && date::read_fixed(minutesAt, 2, offsetMinutes)) {
+                        if (offsetMinutes > 59) {
+                            return ParseResult{first, ConvertError::INVALID};
+                        }
+                        offsetEnd = minutesAt + 2;
+                    } else {
+                        offsetMinutes = 0;
+                    }
+                    const std::int64_t offset = offsetHours * 3600 + offsetMinutes * 60;
+                    seconds -= *at == '+' ? offset : -offset;
+                    at = offsetEnd;
+                }
+            }
+            value.seconds = seconds;
+            return ParseResult{at, ConvertError::NONE};
+        }
+
+        // Writes a date in its layout at `first`, which has room for maxNumberLength characters. Years
+        // past 9999 or before 0 don't fit the fixed width and are written with all their digits
+        template <DateFormat F>
+        char *to_chars(char *first, const FormattedDate<F> &value) {
+            std::int64_t year;
+            unsigned month, day;
+            date::civil_from_days(value.days, year, month, day);
+
+            char *yearEnd;
+            char yearDigits[maxNumberLength];
+            if (year >= 0 && year <= 9999) {
+                yearEnd = date::write_fixed(yearDigits, static_cast<unsigned>(year), 4);
+            } else {
+                yearEnd = to_chars(yearDigits, year);
+            }
+            const auto yearLength = static_cast<std::size_t>(yearEnd - yearDigits);
+
+            switch (F) {
+                case DateFormat::US:
+                    first = date::write_fixed(first, month, 2);
+                    *first++ = '/';
+                    first = date::write_fixed(first, day, 2);
+                    *first++ = '/';
+                    std::memcpy(first, yearDigits, yearLength);
+                    return first + yearLength;
+                case DateFormat::EUROPEAN:
+                    first = date::write_fixed(first, day, 2);
+                    *first++ = '.';
+                    first = date::write_fixed(first, month, 2);
+                    *first++ = '.';
+                    std::memcpy(first, yearDigits, yearLength);
+                    return first + yearLength;
+                default:
+                    std::memcpy(first, yearDigits, yearLength);
+                    first += yearLength;
+                    if (F == DateFormat::ISO) {
+                        *first++ = '-';
+                    }
+                    first = date::write_fixed(first, month, 2);
+                    if (F == DateFormat::ISO) {
+                        *first++ = '-';
+                    }
+                    return date::write_fixed(first, day, 2);
+            }
+        }
+
+        // YYYY-MM-DDTHH:MM:SSZ
+        inline char *to_chars(char *first, const Timestamp &value) {
+            std::int64_t days = value.seconds / date::secondsPerDay;
+            std::int64_t seconds = value.seconds % date::secondsPerDay;
+            if (seconds < 0) {
+                seconds += date::secondsPerDay;
+                --days;
+            }
+
+            first = to_chars(first, Date(days));
+            *first++ = 'T';
+            first = date::write_fixed(first, static_cast<unsigned>(seconds / 3600), 2);
+            *first++ = ':';
+            first = date::write_fixed(first, static_cast<unsigned>(seconds / 60 % 60), 2);
+            *first++ = ':';
+            first = date::write_fixed(first, static_cast<unsigned>(seconds % 60), 2);
+            *first++ = 'Z';
+            return first;
+        }
+    }
+}
+
+#endif //RAPIDCSV_DATE_TIME_HPP
@@ -0,0 +1,434 @@
+#ifndef RAPIDCSV_NUMBER_FORMATTER_HPP
+#define RAPIDCSV_NUMBER_FORMATTER_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace rapidcsv {
+    namespace convert {
+
+        // Room to_chars() needs for any integer or floating point value
+        static constexpr std::size_t maxNumberLength = 32;
+
+        namespace number {
+            // "00" to "99", two digits are written at a time
+            static constexpr char digitPairs[201] =
+                    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                    "8081828384858687888990919293949596979899";
+
+            inline int digit_count(std::uint64_t value) {
+                int count = 1;
+                for (;;) {
+                    if (value < 10) return count;
+                    if (value < 100) return count + 1;
+                    if (value < 1000) return count + 2;
+                    if (value < 10000) return count + 3;
+                    value /= 10000;
+                    count += 4;
+                }
+            }
+
+            // Writes the `count` digits of `value` ending at `last`
+            inline void write_digits(char *last, std::uint64_t value) {
+                while (value >= 100) {
+                    const auto pair = static_cast<std::size_t>(value % 100) * 2;
+                    value /= 100;
+                    *--last = digitPairs[pair + 1];
+                    *--last = digitPairs[pair];
+                }
+                if (value >= 10) {
+                    const auto pair = static_cast<std::size_t>(value) * 2;
+                    *--last = digitPairs[pair + 1];
+                    *--last = digitPairs[pair];
+                } else {
+                    *--last = static_cast<char>('0' + value);
+                }
+            }
+
+            inline char *write_unsigned(char *first, std::uint64_t value) {
+                char *last = first + digit_count(value);
+                write_digits(last, value);
+                return last;
+            }
+
+            // Grisu3, after Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with
+            // Integers". The digits it gives are the shortest that read back to the same value, and the
+            // closest to it among those; the rare values it can't decide go to shortest_exact().
+            namespace grisu {
+                // f * 2^e
+                struct DiyFp {
+                    std::uint64_t f;
+                    int e;
+                };
+
+                // Upper 64 bits of the product, rounded
+                inline DiyFp multiply(const DiyFp &x, const DiyFp &y) {
+                    const std::uint64_t xLo = x.f & 0xFFFFFFFFu, xHi = x.f >> 32;
+                    const std::uint64_t yLo = y.f & 0xFFFFFFFFu, yHi = y.f >> 32;
+                    const std::uint64_t p0 = xLo * yLo, p1 = xLo * yHi, p2 = xHi * yLo, p3 = xHi * yHi;
+                    std::uint64_t middle = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+                    middle += std::uint64_t(1) << 31;
+                    return DiyFp{p3 + (p1 >> 32) + (p2 >> 32) + (middle >> 32), x.e + y.e + 64};
+                }
+
+                inline DiyFp normalize(DiyFp x) {
+                    while ((x.f >> 63) == 0) {
+                        x.f <<= 1;
+                        --x.e;
+                    }
+                    return x;
+                }
+
+                // A value and the boundaries halfway to its neighbours, all with the exponent of the upper one
+                struct Boundaries {
+                    DiyFp w, minus, plus;
+                };
+
+                template <typename T>
+                Boundaries boundaries(T value) {
+                    using Bits = typename std::conditional<sizeof(T) == 8, std::uint64_t, std::uint32_t>::type;
+                    constexpr int precision = std::numeric_limits<T>::digits;
+                    constexpr int bias = std::numeric_limits<T>::max_exponent - 1 + (precision - 1);
+                    constexpr std::uint64_t hiddenBit = std::uint64_t(1) << (precision - 1);
+
+                    Bits bits;
+                    std::memcpy(&bits, &value, sizeof(bits));
+                    const auto exponent = static_cast<int>(static_cast<std::uint64_t>(bits) >> (precision - 1));
+                    const std::uint64_t fraction = static_cast<std::uint64_t>(bits) & (hiddenBit - 1);
+
+                    const DiyFp v = exponent == 0 ? DiyFp{fraction, 1 - bias}
+                                                  : DiyFp{fraction + hiddenBit, exponent - bias};
+                    // The gap below a power of two is half the one above it
+                    const bool lowerCloser = fraction == 0 && exponent > 1;
+                    const DiyFp plus = normalize(DiyFp{2 * v.f + 1, v.e - 1});
+                    DiyFp minus = lowerCloser ? DiyFp{4 * v.f - 1, v.e - 2} : DiyFp{2 * v.f - 1, v.e - 1};
+                    minus.f <<= minus.e - plus.e;
+                    minus.e = plus.e;
+                    return Boundaries{normalize(v), minus, plus};
+                }
+
+                struct CachedPower {
+                    std::uint64_t f;
+                    int e;
+                    int k;
+                };
+
+                // 10^k for k = -300, -292, ..., 324, normalized to 64 bits
+                inline CachedPower cached_power(int e) {
+                    static constexpr CachedPower powers[] = {
+                        {0xAB70FE17C79AC6CA, -1060, -300},
+                        {0xFF77B1FCBEBCDC4F, -1034, -292},
+                        {0xBE5691EF416BD60C, -1007, -284},
+                        {0x8DD01FAD907FFC3C, -980, -276},
+                        {0xD3515C2831559A83, -954, -268},
+                        {0x9D71AC8FADA6C9B5, -927, -260},
+                        {0xEA9C227723EE8BCB, -901, -252},
+                        {0xAECC49914078536D, -874, -244},
+                        {0x823C12795DB6CE57, -847, -236},
+                        {0xC21094364DFB5637, -821, -228},
+                        {0x9096EA6F3848984F, -794, -220},
+                        {0xD77485CB25823AC7, -768, -212},
+                        {0xA086CFCD97BF97F4, -741, -204},
+                        {0xEF340A98172AACE5, -715, -196},
+                        {0xB23867FB2A35B28E, -688, -188},
+                        {0x84C8D4DFD2C63F3B, -661, -180},
+                        {0xC5DD44271AD3CDBA, -635, -172},
+                        {0x936B9FCEBB25C996, -608, -164},
+                        {0xDBAC6C247D62A584, -582, -156},
+                        {0xA3AB66580D5FDAF6, -555, -148},
+                        {0xF3E2F893DEC3F126, -529, -140},
+                        {0xB5B5ADA8AAFF80B8, -502, -132},
+                        {0x87625F056C7C4A8B, -475, -124},
+                        {0xC9BCFF6034C13053, -449, -116},
+                        {0x964E858C91BA2655, -422, -108},
+                        {0xDFF9772470297EBD, -396, -100},
+                        {0xA6DFBD9FB8E5B88F, -369, -92},
+                        {0xF8A95FCF88747D94, -343, -84},
+                        {0xB94470938FA89BCF, -316, -76},
+                        {0x8A08F0F8BF0F156B, -289, -68},
+                        {0xCDB02555653131B6, -263, -60},
+                        {0x993FE2C6D07B7FAC, -236, -52},
+                        {0xE45C10C42A2B3B06, -210, -44},
+                        {0xAA242499697392D3, -183, -36},
+                        {0xFD87B5F28300CA0E, -157, -28},
+                        {0xBCE5086492111AEB, -130, -20},
+                        {0x8CBCCC096F5088CC, -103, -12},
+                        {0xD1B71758E219652C, -77, -4},
+                        {0x9C40000000000000, -50, 4},
+                        {0xE8D4A51000000000, -24, 12},
+                        {0xAD78EBC5AC620000, 3, 20},
+                        {0x813F3978F8940984, 30, 28},
+                        {0xC097CE7BC90715B3, 56, 36},
+                        {0x8F7E32CE7BEA5C70, 83, 44},
+                        {0xD5D238A4ABE98068, 109, 52},
+                        {0x9F4F2726179A2245, 136, 60},
+                        {0xED63A231D4C4FB27, 162, 68},
+                        {0xB0DE65388CC8ADA8, 189, 76},
+                        {0x83C7088E1AAB65DB, 216, 84},
+                        {0xC45D1DF942711D9A, 242, 92},
+                        {0x924D692CA61BE758, 269, 100},
+                        {0xDA01EE641A708DEA, 295, 108},
+                        {0xA26DA3999AEF774A, 322, 116},
+                        {0xF209787BB47D6B85, 348, 124},
+                        {0xB454E4A179DD1877, 375, 132},
+                        {0x865B86925B9BC5C2, 402, 140},
+                        {0xC83553C5C8965D3D, 428, 148},
+                        {0x952AB45CFA97A0B3, 455, 156},
+                        {0xDE469FBD99A05FE3, 481, 164},
+                        {0xA59BC234DB398C25, 508, 172},
+                        {0xF6C69A72A3989F5C, 534, 180},
+                        {0xB7DCBF5354E9BECE, 561, 188},
+                        {0x88FCF317F22241E2, 588, 196},
+                        {0xCC20CE9BD35C78A5, 614, 204},
+                        {0x98165AF37B2153DF, 641, 212},
+                        {0xE2A0B5DC971F303A, 667, 220},
+                        {0xA8D9D1535CE3B396, 694, 228},
+                        {0xFB9B7CD9A4A7443C, 720, 236},
+                        {0xBB764C4CA7A44410, 747, 244},
+                        {0x8BAB8EEFB6409C1A, 774, 252},
+                        {0xD01FEF10A657842C, 800, 260},
+                        {0x9B10A4E5E9913129, 827, 268},
+                        {0xE7109BFBA19C0C9D, 853, 276},
+                        {0xAC2820D9623BF429, 880, 284},
+                        {0x80444B5E7AA7CF85, 907, 292},
+                        {0xBF21E44003ACDD2D, 933, 300},
+                        {0x8E679C2F5E44FF8F, 960, 308},
+                        {0xD433179D9C8CB841, 986, 316},
+                        {0x9E19DB92B4E31BA9, 1013, 324}
+                    };
+                    // Puts the scaled exponent into [-60, -32]
+                    const int f = -60 - e - 1;
+                    const int k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+                    return powers[(300 + k + 7) / 8];
+                }
+
+                inline int largest_pow10(std::uint32_t n, std::uint32_t &pow10) {
+                    int digits = 10;
+                    for (pow10 = 1000000000; pow10 > n && digits > 1; pow10 /= 10) {
+                        --digits;
+                    }
+                    return digits;
+                }
+
+                // Moves the last digit closer to the value while it stays within the unsafe interval, then
+                // checks that the digits are the closest ones despite the error of the scaled products,
+                // `unit` wide on each side. False when that can't be told at this precision
+                inline bool round_weed(char *digits, int length, std::uint64_t distance, std::uint64_t unsafe,
+                                       std::uint64_t rest, std::uint64_t tenK, std::uint64_t unit) {
+                    const std::uint64_t smallDistance = distance - unit;
+                    const std::uint64_t bigDistance = distance + unit;
+                    while (rest < smallDistance && unsafe - rest >= tenK &&
+                           (rest + tenK < smallDistance || smallDistance - rest >= rest + tenK - smallDistance)) {
+                        --digits[length - 1];
+                        rest += tenK;
+                    }
+                    // Would the digits move once more for a value `unit` further away?
+                    if (rest < bigDistance && unsafe - rest >= tenK &&
+                        (rest + tenK < bigDistance || bigDistance - rest > rest + tenK - bigDistance)) {
+                        return false;
+                    }
+                    // Safely inside the interval
+                    return 2 * unit <= rest && rest <= unsafe - 4 * unit;
+                }
+
+                // Digits of the scaled value from the top of the unsafe interval down, until they fall inside
+                // it. `exponent` gets the power of ten of the last digit added to it
+                inline bool generate(char *digits, int &length, int &exponent, DiyFp minus, DiyFp w, DiyFp plus) {
+                    std::uint64_t unit = 1;
+                    const std::uint64_t tooHigh = plus.f + unit;
+                    std::uint64_t unsafe = tooHigh - (minus.f - unit);
+                    const int shift = -w.e;
+                    const std::uint64_t one = std::uint64_t(1) << shift;
+
+                    auto integral = static_cast<std::uint32_t>(tooHigh >> shift);
+                    std::uint64_t fractional = tooHigh & (one - 1);
+
+                    std::uint32_t pow10;
+                    for (int n = largest_pow10(integral, pow10); n > 0; --n, pow10 /= 10) {
+                        digits[length++] = static_cast<char>('0' + integral / pow10);
+                        integral %= pow10;
+                        const std::uint64_t rest = (static_cast<std::uint64_t>(integral) << shift) + fractional;
+                        if (rest < unsafe) {
+                            exponent += n - 1;
+                            return round_weed(digits, length, tooHigh - w.f, unsafe, rest,
+                                              static_cast<std::uint64_t>(pow10) << shift, unit);
+                        }
+                    }
+
+                    for (;;) {
+                        fractional *= 10;
+                        unit *= 10;
+                        unsafe *= 10;
+                        digits[length++] = static_cast<char>('0' + (fractional >> shift));
+                        fractional &= one - 1;
+                        --exponent;
+                        if (fractional < unsafe) {
+                            return round_weed(digits, length, (tooHigh - w.f) * unit, unsafe, fractional, one, unit);
+                        }
+                    }
+                }
+
+                // Grisu3: digits of a finite positive value, which is digits * 10^exponent. False for the
+                // few values, about one in two hundred, whose digits it can't prove shortest and closest
+                template <typename T>
+                bool shortest(T value, char *digits, int &length, int &exponent) {
+                    const Boundaries bounds = boundaries(value);
+                    const CachedPower cached = cached_power(bounds.plus.e);
+                    const DiyFp power{cached.f, cached.e};
+
+                    length = 0;
+                    exponent = -cached.k;
+                    return generate(digits, length, exponent, multiply(bounds.minus, power),
+                                    multiply(bounds.w, power), multiply(bounds.plus, power));
+                }
+            }
+
+            // candidate * 10^power read as a T
+            template <typename T>
+            T read_back(std::uint64_t candidate, int power) {
+                char text[maxNumberLength];
+                char *end = write_unsigned(text, candidate);
+                *end++ = 'e';
+                if (power < 0) {
+                    *end++ = '-';
+                }
+                *write_unsigned(end, static_cast<std::uint64_t>(power < 0 ? -power : power)) = '\0';
+                // No decimal point, so the locale has no say
+                return std::is_same<T, float>::value ? static_cast<T>(std::strtof(text, nullptr))
+                                                     : static_cast<T>(std::strtod(text, nullptr));
+            }
+
+            // Exact digits for what Grisu3 rejects, given the `length` it stopped at: no fewer digits read
+            // back. From there, the correctly rounded digits, or their neighbour on the other side of the
+            // value, until one parses back to it. The neighbour only ever wins next to a power of two,
+            // where the gap below the value is the narrower
+            template <typename T>
+            void shortest_exact(T value, char *digits, int &length, int &exponent) {
+                constexpr int maxDigits = std::numeric_limits<T>::max_digits10;
+                char text[maxNumberLength];
+                for (int precision = length > 0 ? length : 1; precision <= maxDigits; ++precision) {
+                    std::snprintf(text, sizeof(text), "%.*e", precision - 1, static_cast<double>(value));
+                    // d.ddde-XX, whatever the decimal point of the locale
+                    std::uint64_t candidate = 0;
+                    const char *at = text;
+                    for (; *at != 'e'; ++at) {
+                        if (*at >= '0' && *at <= '9') {
+                            candidate = candidate * 10 + static_cast<std::uint64_t>(*at - '0');
+                        }
+                    }
+                    const int power = std::atoi(at + 1) - (precision - 1);
+
+                    const T back = read_back<T>(candidate, power);
+                    if (back != value && precision < maxDigits) {
+                        candidate = back < value ? candidate + 1 : candidate - 1;
+                        if (read_back<T>(candidate, power) != value) {
+                            continue;
+                        }
+                    }
+                    length = digit_count(candidate);
+                    write_digits(digits + length, candidate);
+                    exponent = power;
+                    while (length > 1 && digits[length - 1] == '0') {
+                        --length;
+                        ++exponent;
+                    }
+                    return;
+                }
+            }
+
+            // Lays out `length` digits with the decimal point at `point`, as in 0.digits * 10^point. Plain
+            // notation for points in (-6, 21], as JavaScript prints numbers, exponent notation otherwise
+            inline char *write_decimal(char *out, const char *digits, int length, int point) {
+                if (point > 0 && point <= 21) {
+                    if (length <= point) {
+                        std::memcpy(out, digits, static_cast<std::size_t>(length));
+                        std::memset(out + length, '0', static_cast<std::size_t>(point - length));
+                        return out + point;
+                    }
+                    std::memcpy(out, digits, static_cast<std::size_t>(point));
+                    out[point] = '.';
+                    std::memcpy(out + point + 1, digits + point, static_cast<std::size_t>(length - point));
+                    return out + length + 1;
+                }
+                if (point <= 0 && point > -6) {
+                    *out++ = '0';
+                    *out++ = '.';
+                    std::memset(out, '0', static_cast<std::size_t>(-point));
+                    out += -point;
+                    std::memcpy(out, digits, static_cast<std::size_t>(length));
+                    return out + length;
+                }
+
+                *out++ = digits[0];
+                if (length > 1) {
+                    *out++ = '.';
+                    std::memcpy(out, digits + 1, static_cast<std::size_t>(length - 1));
+                    out += length - 1;
+                }
+                *out++ = 'e';
+                int exponent = point - 1;
+                *out++ = exponent < 0 ? '-' : '+';
+                exponent = exponent < 0 ? -exponent : exponent;
+                if (exponent < 10) {
+                    // At least two digits, as printf writes them
+                    *out++ = '0';
+                }
+                return write_unsigned(out, static_cast<std::uint64_t>(exponent));
+            }
+        }
+
+        // Writes `value` in decimal at `first`, which has room for maxNumberLength characters, and returns
+        // the end of what was written
+        template <typename T, typename std::enable_if<std::is_integral<T>::value &&
+                                                      !std::is_same<T, bool>::value>::type * = nullptr>
+        char *to_chars(char *first, T value) {
+            if (value < 0) {
+                *first++ = '-';
+                // Negated in the unsigned type, so that the minimum has a magnitude too
+                using Unsigned = typename std::make_unsigned<T>::type;
+                return number::write_unsigned(first, static_cast<std::uint64_t>(
+                        static_cast<Unsigned>(0 - static_cast<Unsigned>(value))));
+            }
+            return number::write_unsigned(first, static_cast<std::uint64_t>(value));
+        }
+
+        // Shortest digits that read back to the same value, closest to it when there are several, see
+        // number::grisu. Infinities and NaN are written as inf, -inf and nan, which parse_float() reads back
+        template <typename T, typename std::enable_if<std::is_same<T, double>::value ||
+                                                      std::is_same<T, float>::value>::type * = nullptr>
+        char *to_chars(char *first, T value) {
+            if (std::isnan(value)) {
+                std::memcpy(first, "nan", 3);
+                return first + 3;
+            }
+            if (std::signbit(value)) {
+                *first++ = '-';
+                value = -value;
+            }
+            if (std::isinf(value)) {
+                std::memcpy(first, "inf", 3);
+                return first + 3;
+            }
+            if (value == 0) {
+                *first = '0';
+                return first + 1;
+            }
+
+            char digits[20];
+            int length, exponent;
+            if (!number::grisu::shortest(value, digits, length, exponent)) {
+                number::shortest_exact(value, digits, length, exponent);
+            }
+            return number::write_decimal(first, digits, length, length + exponent);
+        }
+    }
+}
+
+#endif //RAPIDCSV_NUMBER_FORMATTER_HPP
@@ -0,0 +1,503 @@
+#ifndef RAPIDCSV_NUMBER_PARSER_HPP
+#define RAPIDCSV_NUMBER_PARSER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace rapidcsv {
+    namespace convert {
+
+        enum class ConvertError : std::uint8_t {
+            NONE,
+            // No number at the start of the range
+            INVALID,
+            // A number, but out of the range of the type: the value is clamped, or infinite
+            OUT_OF_RANGE
+        };
+
+        // Where parsing stopped, just past the number, and what went wrong if anything
+        struct ParseResult {
+            const char *end;
+            ConvertError error;
+
+            bool ok() const {
+                return error == ConvertError::NONE;
+            }
+        };
+
+        namespace number {
+            inline bool is_digit(char c) {
+                return static_cast<unsigned>(c - '0') < 10;
+            }
+
+            inline bool is_space(char c) {
+                return c == ' ' || (c >= '\t' && c <= '\r');
+            }
+
+            inline const char *skip_space(const char *first, const char *last) {
+                while (first != last && is_space(*first)) {
+                    ++first;
+                }
+                return first;
+            }
+
+            // Matches `word` case insensitively at the start of [first, last)
+            inline bool starts_with(const char *first, const char *last, const char *word) {
+                const std::size_t length = std::strlen(word);
+                if (static_cast<std::size_t>(last - first) < length) {
+                    return false;
+                }
+                for (std::size_t i = 0; i < length; ++i) {
+                    if ((first[i] | 0x20) != word[i]) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            // Layout of the IEEE 754 binary formats, and the bounds of Clinger's fast path: a mantissa
+            // and a power of ten that are both exact in the type give an exactly rounded product
+            template <typename T>
+            struct FloatFormat;
+
+            template <>
+            struct FloatFormat<double> {
+                using Bits = std::uint64_t;
+                static constexpr unsigned mantissaBits = 52;
+                static constexpr unsigned exponentBits = 11;
+                static constexpr int bias = -1023;
+                static constexpr std::uint64_t maxFastMantissa = std::uint64_t(1) << 53;
+                static constexpr int maxFastExponent = 22;
+
+                static double power(int exponent) {
+                    static constexpr double powers[] = {
+                            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                    };
+                    return powers[exponent];
+                }
+            };
+
+            template <>
+            struct FloatFormat<float> {
+                using Bits = std::uint32_t;
+                static constexpr unsigned mantissaBits = 23;
+                static constexpr unsigned exponentBits = 8;
+                static constexpr int bias = -127;
+                static constexpr std::uint64_t maxFastMantissa = std::uint64_t(1) << 24;
+                static constexpr int maxFastExponent = 10;
+
+                static float power(int exponent) {
+                    static constexpr float powers[] = {
+                            1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+                    };
+                    return powers[exponent];
+                }
+            };
+
+            // Arbitrary precision decimal, 0.d[0]d[1]...d[n-1] * 10^point, for the inputs the fast path
+            // can't round exactly. Shifting it by powers of two until it holds the binary mantissa
+            // gives an exactly rounded result for any input.
+            class Decimal {
+                static constexpr std::size_t capacity = 800;
+                // Largest shift applied at once, so that digit << shift cannot overflow a uint64
+                static constexpr unsigned maxShift = 60;
+
+                std::uint8_t _digits[capacity];
+                std::size_t _count;
+                int _point;
+                // Nonzero digits were dropped past the capacity
+                bool _truncated;
+
+            public:
+                Decimal() : _count(0), _point(0), _truncated(false) {}
+
+                // Appends the next digit of the significand, `integral` when it comes before the decimal point
+                void push_digit(char c, bool integral) {
+                    const auto digit = static_cast<std::uint8_t>(c - '0');
+                    if (_count == 0 && digit == 0) {
+                        // Leading zeros only move the point when they follow it
+                        _point -= integral ? 0 : 1;
+                        return;
+                    }
+                    if (_count < capacity) {
+                        _digits[_count++] = digit;
+                    } else if (digit != 0) {
+                        _truncated = true;
+                    }
+                    _point += integral ? 1 : 0;
+                }
+
+                void scale(long exponent) {
+                    _point += static_cast<int>(exponent);
+                    trim();
+                }
+
+                // Exactly rounded value, infinite when out of range
+                template <typename T>
+                T to_float(bool negative, bool &overflow) {
+                    using Format = FloatFormat<T>;
+                    constexpr int maxExponent = (1 << Format::exponentBits) - 1;
+                    static const unsigned powers[] = {1, 3, 6, 9, 13, 16, 19, 23, 26};
+                    constexpr int powerCount = sizeof(powers) / sizeof(powers[0]);
+
+                    std::uint64_t mantissa = 0;
+                    int exponent = Format::bias;
+                    overflow = false;
+
+                    if (_count == 0 || _point < -330) {
+                        // Zero, or too small for a denormal
+                        mantissa = 0;
+                    } else if (_point > 310) {
+                        overflow = true;
+                    } else {
+                        // Scale by powers of two into [0.5, 1)
+                        exponent = 0;
+                        while (_point > 0) {
+                            const unsigned n = _point >= powerCount ? 27 : powers[_point];
+                            shift_right(n);
+                            exponent += static_cast<int>(n);
+                        }
+                        while (_point < 0 || (_point == 0 && _digits[0] < 5)) {
+                            const unsigned n = -_point >= powerCount ? 27 : powers[-_point];
+                            shift_left(n);
+                            exponent -= static_cast<int>(n);
+                        }
+                        // The binary formats keep their mantissa in [1, 2)
+                        --exponent;
+
+                        if (exponent < Format::bias + 1) {
+                            // Denormal
+                            const int n = Format::bias + 1 - exponent;
+                            shift_right(static_cast<unsigned>(n));
+                            exponent += n;
+                        }
+
+                        if (exponent - Format::bias >= maxExponent) {
+                            overflow = true;
+                        } else {
+                            shift_left(1 + Format::mantissaBits);
+                            mantissa = rounded_integer();
+                            if (mantissa == std::uint64_t(2) << Format::mantissaBits) {
+                                // Rounding carried into a new bit
+                                mantissa >>= 1;
+                                ++exponent;
+                                overflow = exponent - Format::bias >= maxExponent;
+                            }
+                            if ((mantissa & (std::uint64_t(1) << Format::mantissaBits)) == 0) {
+                                exponent = Format::bias;
+                            }
+                        }
+                    }
+
+                    if (overflow) {
+                        mantissa = 0;
+                        exponent = maxExponent + Format::bias;
+                    }
+
+                    auto bits = static_cast<typename Format::Bits>(
+                            (mantissa & ((std::uint64_t(1) << Format::mantissaBits) - 1)) |
+                            (static_cast<std::uint64_t>((exponent - Format::bias) & maxExponent) << Format::mantissaBits));
+                    if (negative) {
+                        bits |= static_cast<typename Format::Bits>(
+                                std::uint64_t(1) << (Format::mantissaBits + Format::exponentBits));
+                    }
+                    T value;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    return value;
+                }
+
+            private:
+                void trim() {
+                    while (_count > 0 && _digits[_count - 1] == 0) {
+                        --_count;
+                    }
+                    if (_count == 0) {
+                        _point = 0;
+                    }
+                }
+
+                // Divides by 2^shift
+                void shift_right(unsigned shift) {
+                    for (; shift > maxShift; shift -= maxShift) {
+                        shift_right_once(maxShift);
+                    }
+                    shift_right_once(shift);
+                }
+
+                void shift_right_once(unsigned shift) {
+                    std::size_t read = 0, write = 0;
+                    std::uint64_t n = 0;
+                    for (; (n >> shift) == 0; ++read) {
+                        if (read >= _count) {
+                            if (n == 0) {
+                                _count = 0;
+                                return;
+                            }
+                            while ((n >> shift) == 0) {
+                                n *= 10;
+                                ++read;
+                            }
+                            break;
+                        }
+                        n = n * 10 + _digits[read];
+                    }
+                    _point -= static_cast<int>(read) - 1;
+
+                    const std::uint64_t mask = (std::uint64_t(1) << shift) - 1;
+                    for (; read < _count; ++read) {
+                        _digits[write++] = static_cast<std::uint8_t>(n >> shift);
+                        n = (n & mask) * 10 + _digits[read];
+                    }
+                    while (n > 0) {
+                        const auto digit = static_cast<std::uint8_t>(n >> shift);
+                        if (write < capacity) {
+                            _digits[write++] = digit;
+                        } else if (digit > 0) {
+                            _truncated = true;
+                        }
+                        n = (n & mask) * 10;
+                    }
+                    _count = write;
+                    trim();
+                }
+
+                // Multiplies by 2^shift
+                void shift_left(unsigned shift) {
+                    for (; shift > maxShift; shift -= maxShift) {
+                        shift_left_once(maxShift);
+                    }
+                    shift_left_once(shift);
+                }
+
+                void shift_left_once(unsigned shift) {
+                    // Least significant digit first
+                    std::uint8_t product[capacity + 20];
+                    std::size_t length = 0;
+                    std::uint64_t n = 0;
+                    for (std::size_t read = _count; read-- > 0;) {
+                        n += static_cast<std::uint64_t>(_digits[read]) << shift;
+                        product[length++] = static_cast<std::uint8_t>(n % 10);
+                        n /= 10;
+                    }
+                    for (; n > 0; n /= 10) {
+                        product[length++] = static_cast<std::uint8_t>(n % 10);
+                    }
+
+                    _point += static_cast<int>(length) - static_cast<int>(_count);
+                    _count = 0;
+                    while (length-- > 0) {
+                        if (_count < capacity) {
+                            _digits[_count++] = product[length];
+                        } else if (product[length] != 0) {
+                            _truncated = true;
+                        }
+                    }
+                    trim();
+                }
+
+                // Integer part, rounded half to even
+                std::uint64_t rounded_integer() const {
+                    if (_point > 20) {
+                        return std::numeric_limits<std::uint64_t>::max();
+                    }
+                    std::uint64_t n = 0;
+                    int i = 0;
+                    for (; i < _point && static_cast<std::size_t>(i) < _count; ++i) {
+                        n = n * 10 + _digits[i];
+                    }
+                    for (; i < _point; ++i) {
+                        n *= 10;
+                    }
+                    if (round_up()) {
+                        ++n;
+                    }
+                    return n;
+                }
+
+                bool round_up() const {
+                    if (_point < 0 || static_cast<std::size_t>(_point) >= _count) {
+                        return false;
+                    }
+                    const auto at = static_cast<std::size_t>(_point);
+                    if (_digits[at] == 5 && at + 1 == _count) {
+                        // Exactly halfway, unless digits were dropped
+                        return _truncated || (at > 0 && _digits[at - 1] % 2 == 1);
+                    }
+                    return _digits[at] >= 5;
+                }
+            };
+        }
+
+        // Parses an optionally signed decimal integer at the start of [first, last), checking for overflow.
+        // Never throws: on overflow `value` is clamped to the range of T
+        template <typename T, typename std::enable_if<std::is_integral<T>::value &&
+                                                      !std::is_same<T, bool>::value>::type * = nullptr>
+        ParseResult parse_integer(const char *first, const char *last, T &value) {
+            const char *at = first;
+            bool negative = false;
+            if (at != last && (*at == '-' || *at == '+')) {
+                negative = *at == '-';
+                ++at;
+            }
+
+            // Magnitude of the bound in the direction of the sign, only -0 is in range for unsigned types
+            const std::uint64_t limit = !negative ? static_cast<std::uint64_t>(std::numeric_limits<T>::max())
+                    : std::is_signed<T>::value ? static_cast<std::uint64_t>(-(std::numeric_limits<T>::min() + 1)) + 1
+                    : 0;
+            const char *digits = at;
+            std::uint64_t magnitude = 0;
+            bool overflow = false;
+            for (; at != last && number::is_digit(*at); ++at) {
+                const auto digit = static_cast<unsigned>(*at - '0');
+                if (digit > limit || magnitude > (limit - digit) / 10) {
+                    overflow = true;
+                } else {
+                    magnitude = magnitude * 10 + digit;
+                }
+            }
+
+            if (at == digits) {
+                return ParseResult{first, ConvertError::INVALID};
+            }
+            if (overflow) {
+                value = negative ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+                return ParseResult{at, ConvertError::OUT_OF_RANGE};
+            }
+            if (!negative) {
+                value = static_cast<T>(magnitude);
+            } else if (magnitude == limit) {
+                // Can't be negated in T
+                value = std::numeric_limits<T>::min();
+            } else {
+                value = static_cast<T>(-static_cast<T>(magnitude));
+            }
+            return ParseResult{at, ConvertError::NONE};
+        }
+
+        // 0 or 1
+        inline ParseResult parse_integer(const char *first, const char *last, bool &value) {
+            unsigned long long number = 0;
+            ParseResult result = parse_integer(first, last, number);
+            if (result.ok() && number > 1) {
+                result.error = ConvertError::OUT_OF_RANGE;
+            }
+            value = number != 0;
+            return result;
+        }
+
+        // Parses a decimal floating point number at the start of [first, last), with an optional sign
+        // and exponent, or inf, infinity or nan in any case. The result is exactly rounded: Clinger's
+        // fast path covers short inputs, number::Decimal all the others. Never throws: out of range
+        // numbers give an infinity
+        template <typename T, typename std::enable_if<std::is_same<T, double>::value ||
+                                                      std::is_same<T, float>::value>::type * = nullptr>
+        ParseResult parse_float(const char *first, const char *last, T &value) {
+            using Format = number::FloatFormat<T>;
+
+            const char *at = first;
+            bool negative = false;
+            if (at != last && (*at == '-' || *at == '+')) {
+                negative = *at == '-';
+                ++at;
+            }
+
+            if (at != last && !number::is_digit(*at) && *at != '.') {
+                if (number::starts_with(at, last, "inf")) {
+                    value = negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+                    return ParseResult{at + (number::starts_with(at, last, "infinity") ? 8 : 3), ConvertError::NONE};
+                }
+                if (number::starts_with(at, last, "nan")) {
+                    value = std::numeric_limits<T>::quiet_NaN();
+                    return ParseResult{at + 3, ConvertError::NONE};
+                }
+                return ParseResult{first, ConvertError::INVALID};
+            }
+
+            // Up to 19 significant digits fit a uint64, the exponent accounts for the rest
+            std::uint64_t mantissa = 0;
+            int significant = 0;
+            long exponent = 0;
+            bool truncated = false;
+
+            const char *integral = at;
+            for (; at != last && number::is_digit(*at); ++at) {
+                if (significant < 19) {
+                    mantissa = mantissa * 10 + static_cast<unsigned>(*at - '0');
+                    significant += mantissa != 0 ? 1 : 0;
+                } else {
+                    ++exponent;
+                    truncated |= *at != '0';
+                }
+            }
+            const char *integralEnd = at;
+            const char *fraction = at;
+            if (at != last && *at == '.') {
+                fraction = ++at;
+                for (; at != last && number::is_digit(*at); ++at) {
+                    if (significant < 19) {
+                        mantissa = mantissa * 10 + static_cast<unsigned>(*at - '0');
+                        significant += mantissa != 0 ? 1 : 0;
+                        --exponent;
+                    } else {
+                        truncated |= *at != '0';
+                    }
+                }
+            }
+            const char *fractionEnd = at;
+            if (integralEnd == integral && fractionEnd == fraction) {
+                return ParseResult{first, ConvertError::INVALID};
+            }
+
+            long explicitExponent = 0;
+            if (at != last && (*at | 0x20) == 'e') {
+                const char *exponentAt = at + 1;
+                bool negativeExponent = false;
+                if (exponentAt != last && (*exponentAt == '-' || *exponentAt == '+')) {
+                    negativeExponent = *exponentAt == '-';
+                    ++exponentAt;
+                }
+                if (exponentAt != last && number::is_digit(*exponentAt)) {
+                    for (; exponentAt != last && number::is_digit(*exponentAt); ++exponentAt) {
+                        if (explicitExponent < 100000) {
+                            explicitExponent = explicitExponent * 10 + (*exponentAt - '0');
+                        }
+                    }
+                    explicitExponent = negativeExponent ? -explicitExponent : explicitExponent;
+                    at = exponentAt;
+                }
+            }
+            exponent += explicitExponent;
+
+            if (mantissa == 0 && !truncated) {
+                value = negative ? -T(0) : T(0);
+                return ParseResult{at, ConvertError::NONE};
+            }
+            if (!truncated && mantissa <= Format::maxFastMantissa &&
+                exponent >= -Format::maxFastExponent && exponent <= Format::maxFastExponent) {
+                T result = static_cast<T>(mantissa);
+                result = exponent < 0 ? result / Format::power(static_cast<int>(-exponent))
+                                      : result * Format::power(static_cast<int>(exponent));
+                value = negative ? -result : result;
+                return ParseResult{at, ConvertError::NONE};
+            }
+
+            number::Decimal decimal;
+            for (const char *digit = integral; digit != integralEnd; ++digit) {
+                decimal.push_digit(*digit, true);
+            }
+            for (const char *digit = fraction; digit != fractionEnd; ++digit) {
+                decimal.push_digit(*digit, false);
+            }
+            decimal.scale(explicitExponent);
+            bool overflow;
+            value = decimal.to_float<T>(negative, overflow);
+            return ParseResult{at, overflow ? ConvertError::OUT_OF_RANGE : ConvertError::NONE};
+        }
+    }
+}
+
+#endif //RAPIDCSV_NUMBER_PARSER_HPP
@@ -0,0 +1,35 @@
+#ifndef RAPIDCSV_CSV_CONSTANTS_HPP
+#define RAPIDCSV_CSV_CONSTANTS_HPP
+
+#include <cstddef>
+
+namespace rapidcsv {
+
+    enum class RowSepType {
+        CRLF, CR, LF
+    };
+
+    // What the readers do with a malformed row, see read::Diagnostics
+    enum class ErrorPolicy {
+        // Throw the matching csv_*_exception, the default
+        THROW,
+        // Drop the row
+        SKIP_ROW,
+        // Keep the row, the malformed field holds its bytes as they are
+        KEEP_RAW,
+        // Drop the row and record a Diagnostic for it
+        COLLECT
+    };
+
+    //////////////////////////////////////////////////////////
+    /////////////////////// CONSTANTS ////////////////////////
+    //////////////////////////////////////////////////////////
+
+    static constexpr char CR = '\r';
+    static constexpr char LF = '\n';
+    static constexpr const char CRLF[3] = "\r\n";
+    static constexpr std::size_t bufLength = 64 * 1024;
+    static constexpr std::size_t cacheLength = 256 * 1024 * 1024;
+}
+
+#endif //RAPIDCSV_CSV_CONSTANTS_HPP
@@ -3,6 +3,11 @@
 
 #include <string>
 #include <sstream>
+#include <locale>
+#include <type_traits>
+#include "detail/convert/number_parser.hpp"
+#include "detail/convert/number_formatter.hpp"
+#include "detail/convert/date_time.hpp"
 
 namespace rapidcsv {
     //////////////////////////////////////////////////////////
@@ -10,19 +15,154 @@ namespace rapidcsv {
     //////////////////////////////////////////////////////////
 
     namespace convert {
+        namespace number {
+            template <typename T>
+            struct is_character : std::integral_constant<bool, std::is_same<T, char>::value ||
+                                                               std::is_same<T, signed char>::value ||
+                                                               std::is_same<T, unsigned char>::value> {};
+
+            // Types without a dedicated parser go through a stream
+            template <typename T, typename Enable = void>
+            struct ValueParser {
+                static T parse(const std::string &pStr) {
+                    std::istringstream in(pStr);
+                    T pVal;
+                    in >> pVal;
+                    return pVal;
+                }
+            };
+
+            // Like a stream, leading whitespace is skipped and parsing stops at the first byte that
+            // can't extend the number. A cell that isn't a number gives 0, an out of range one the
+            // nearest bound or an infinity
+            template <typename T>
+            struct ValueParser<T, typename std::enable_if<std::is_integral<T>::value && !is_character<T>::value>::type> {
+                static T parse(const std::string &pStr) {
+                    const char *first = skip_space(pStr.data(), pStr.data() + pStr.size());
+                    T pVal = T();
+                    parse_integer(first, pStr.data() + pStr.size(), pVal);
+                    return pVal;
+                }
+            };
+
+            template <typename T>
+            struct ValueParser<T, typename std::enable_if<std::is_same<T, double>::value ||
+                                                          std::is_same<T, float>::value>::type> {
+                static T parse(const std::string &pStr) {
+                    const char *first = skip_space(pStr.data(), pStr.data() + pStr.size());
+                    T pVal = T();
+                    parse_float(first, pStr.data() + pStr.size(), pVal);
+                    return pVal;
+                }
+            };
+
+            // Read as a character, as a stream does
+            template <typename T>
+            struct ValueParser<T, typename std::enable_if<is_character<T>::value>::type> {
+                static T parse(const std::string &pStr) {
+                    const char *first = skip_space(pStr.data(), pStr.data() + pStr.size());
+                    return first != pStr.data() + pStr.size() ? static_cast<T>(*first) : T();
+                }
+            };
+
+            // No exactly rounded parser for the extended formats, the stream is kept locale independent
+            template <>
+            struct ValueParser<long double> {
+                static long double parse(const std::string &pStr) {
+                    std::istringstream in(pStr);
+                    in.imbue(std::locale::classic());
+                    long double pVal = 0;
+                    in >> pVal;
+                    return pVal;
+                }
+            };
+
+            // Surrounding spaces are skipped, a cell that isn't a date gives 1970-01-01
+            template <DateFormat F>
+            struct ValueParser<FormattedDate<F>> {
+                static FormattedDate<F> parse(const std::string &pStr) {
+                    FormattedDate<F> pVal;
+                    parse_date(skip_space(pStr.data(), pStr.data() + pStr.size()), pStr.data() + pStr.size(), pVal);
+                    return pVal;
+                }
+            };
+
+            template <>
+            struct ValueParser<Timestamp> {
+                static Timestamp parse(const std::string &pStr) {
+                    Timestamp pVal;
+                    parse_timestamp(skip_space(pStr.data(), pStr.data() + pStr.size()), pStr.data() + pStr.size(), pVal);
+                    return pVal;
+                }
+            };
+
+            // Types without a dedicated formatter go through a stream
+            template <typename T, typename Enable = void>
+            struct ValueFormatter {
+                static std::string format(const T &pVal) {
+                    std::ostringstream out;
+                    out << pVal;
+                    return out.str();
+                }
+            };
+
+            // Digits are written into a stack buffer, the string is the only allocation
+            template <typename T>
+            struct ValueFormatter<T, typename std::enable_if<(std::is_integral<T>::value && !is_character<T>::value &&
+                                                              !std::is_same<T, bool>::value) ||
+                                                             std::is_same<T, double>::value ||
+                                                             std::is_same<T, float>::value>::type> {
+                static std::string format(const T &pVal) {
+                    char buffer[maxNumberLength];
+                    return std::string(buffer, to_chars(buffer, pVal));
+                }
+            };
+
+            template <typename T>
+            struct ValueFormatter<T, typename std::enable_if<is_date_time<T>::value>::type> {
+                static std::string format(const T &pVal) {
+                    char buffer[maxNumberLength];
+                    return std::string(buffer, to_chars(buffer, pVal));
+                }
+            };
+
+            template <>
+            struct ValueFormatter<bool> {
+                static std::string format(const bool &pVal) {
+                    return pVal ? "1" : "0";
+                }
+            };
+
+            // Written as a character, as a stream does
+            template <typename T>
+            struct ValueFormatter<T, typename std::enable_if<is_character<T>::value>::type> {
+                static std::string format(const T &pVal) {
+                    return std::string(1, static_cast<char>(pVal));
+                }
+            };
+
+            template <>
+            struct ValueFormatter<long double> {
+                static std::string format(const long double &pVal) {
+                    std::ostringstream out;
+                    out.imbue(std::locale::classic());
+                    out << pVal;
+                    return out.str();
+                }
+            };
+        }
+
+        // Integers and floating point values are formatted without a stream, see to_chars(). Floating
+        // point values get the shortest digits that parse back to the same value
         template<typename T>
         std::string convert_to_string(const T &pVal) {
-            std::ostringstream out;
-            out << pVal;
-            return out.str();
+            return number::ValueFormatter<T>::format(pVal);
         }
 
+        // Arithmetic types are parsed straight from the characters, see parse_integer() and parse_float()
         template<typename T>
         T convert_to_val(const std::string &pStr) {
-            std::istringstream in(pStr);
-            T pVal;
-            in >> pVal;
-            return pVal;
+            return number::ValueParser<T>::parse(pStr);
         }
     }
 
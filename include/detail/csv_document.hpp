@@ -4,46 +4,62 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
-#include <tuple>
-#include <map>
 #include <utility>
 #include <fstream>
 #include <iterator>
-#include <sstream>
 #include <algorithm>
-#include <numeric>
-
-#include "detail/reader/simple_reader.hpp"
-#include "detail/reader/supply_reader.hpp"
-#include "detail/reader/readable_wrapper.hpp"
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+
+#include "detail/csv_constants.hpp"
+#include "detail/reader/mapped_file.hpp"
+#include "detail/reader/parallel_reader.hpp"
+#include "detail/reader/prefetch_reader.hpp"
+#include "detail/reader/diagnostics.hpp"
+#include "detail/reader/scan_stats.hpp"
 #include "detail/document/properties.hpp"
 #include "detail/document/document.hpp"
+#include "detail/document/schema.hpp"
+#include "detail/document/typed_column.hpp"
+#include "detail/document/mesh.hpp"
 #include "detail/csv_reader.hpp"
 #include "detail/csv_convert.hpp"
-#include "detail/csv_iterator.hpp"
-#include "detail/util/fp.hpp"
+#include "detail/convert/column_converter.hpp"
 
 namespace rapidcsv {
     namespace doc {
-        class CSVDocument : public Document {
-            friend Document rapidcsv::load(const std::string&);
-            friend Document rapidcsv::load(const Properties&);
-            friend void rapidcsv::save(const doc::CSVDocument&);
-            friend void rapidcsv::save(const doc::CSVDocument&, const std::string&);
+        class CSVDocument;
+    }
 
-            using Document::Document;
-            using rapidcsv::read::SimpleReader;
+    doc::CSVDocument load(const Properties &properties);
+    void save(const doc::CSVDocument &document, const std::string &path);
+    void save(const doc::CSVDocument &document);
 
-            using MeshRow = std::unordered_map<std::size_t, std::string>;
-            using Entry = MeshRow::value_type;
+    namespace doc {
 
-            CSVDocument(CSVDocument&&) = default;
-            CSVDocument(const CSVDocument&) = default;
+        // Document parsed whole when it is loaded. Cells are kept in a Mesh, the header row and the row
+        // label column included, and the columns inferred as numbers in a TypedColumn each
+        class CSVDocument : public Document {
+            friend CSVDocument rapidcsv::load(const Properties &);
+            friend void rapidcsv::save(const CSVDocument &, const std::string &);
+            friend void rapidcsv::save(const CSVDocument &);
 
-            explicit CSVDocument(std::vector<MeshRow>&& data, Properties properties)
-                    :Document(std::move(properties)), documentMesh(std::move(data)) {}
+            explicit CSVDocument(Mesh &&data, Properties properties)
+                    : Document(std::move(properties)), documentMesh(std::move(data)) {
+                indexColumns();
+                indexRows();
+            }
 
         public:
+            using Document::SetColumn;
+            using Document::GetCell;
+            using Document::SetCell;
+            using Document::SetColumnLabel;
+            using Document::column_count;
+
+            CSVDocument(CSVDocument &&) = default;
+            CSVDocument(const CSVDocument &) = default;
 
             //////////////////////////////////////////////////////////
             /////////////////////// COLUMNS //////////////////////////
@@ -62,86 +78,66 @@ namespace rapidcsv {
 
             template<typename T>
             std::vector<T> GetColumn(const size_t columnIndex) const {
-                return reader_to_vector(_GetColumn(getColumnIndex(columnIndex)),
-                                        &rapidcsv::convert::convert_to_val<T>);
+                return column_to_vector<T>(getColumnIndex(columnIndex));
             }
 
             template<typename T>
             std::vector<T> GetColumn(const std::string &columnName) const {
-                return reader_to_vector(_GetColumn(getColumnIndex(columnName)),
-                                        &rapidcsv::convert::convert_to_val<T>);
+                return column_to_vector<T>(getColumnIndex(columnName));
             }
 
-            std::vector<std::string> GetColumn(const std::string &columnName, const std::string& fillValue) const {
-
+            // The cells that aren't numbers of the type are flagged in `failures`
+            template<typename T>
+            std::vector<T> GetColumn(const size_t columnIndex, rapidcsv::convert::FailureBitmap &failures) const {
+                return _GetColumn<T>(getColumnIndex(columnIndex), failures);
             }
 
-            std::vector<std::string> GetColumn(const std::size_t &columnIndex, const std::string& fillValue) const {
-
+            template<typename T>
+            std::vector<T> GetColumn(const std::string &columnName, rapidcsv::convert::FailureBitmap &failures) const {
+                return _GetColumn<T>(getColumnIndex(columnName), failures);
             }
 
-            std::vector<std::string> GetColumn(const std::string &columnName) {
+            std::vector<std::string> GetColumn(const std::string &columnName, const std::string& fillValue) const {
+                return _GetColumn(getColumnIndex(columnName), fillValue);
+            }
 
+            std::vector<std::string> GetColumn(const std::size_t &columnIndex, const std::string& fillValue) const {
+                return _GetColumn(getColumnIndex(columnIndex), fillValue);
             }
 
-            std::vector<std::string> GetColumn(const std::size_t &columnIndex) {
+            std::vector<std::string> GetColumn(const std::string &columnName) const {
+                return column_to_vector<std::string>(getColumnIndex(columnName));
+            }
 
+            std::vector<std::string> GetColumn(const std::size_t &columnIndex) const {
+                return column_to_vector<std::string>(getColumnIndex(columnIndex));
             }
 
             // SET
-            template<>
             std::size_t SetColumn(const size_t columnIndex, const std::vector<std::string>& colData) {
-                using rapidcsv::read::wrapped;
-                using rapidcsv::read::enumerate;
-
-                for (const auto& e_row : enumerate(wrapped(documentMesh))) {
-                    MeshRow& row = std::get<1>(e_row);
-                    std::size_t index = std::get<0>(e_row);
-                    row[columnIndex] = colData[index];
-                }
-
-                return documentMesh.size();
+                return setColumn(getColumnIndex(columnIndex), colData);
             }
 
-            template<>
-            std::size_t SetColumn(const size_t columnIndex, std::vector<std::string>&& colData) {
-                using rapidcsv::read::wrapped;
-                using rapidcsv::read::enumerate;
-
-                for (const auto& e_row : enumerate(wrapped(documentMesh))) {
-                    MeshRow& row = std::get<1>(e_row);
-                    std::size_t index = std::get<0>(e_row);
-                    row.emplace(std::piecewise_construct,
-                                std::forward_as_tuple(index),
-                                std::forward_as_tuple(std::move(colData)[index]));
-                }
-
-                return documentMesh.size();
+            std::size_t SetColumn(const std::string &columnName, const std::vector<std::string>& colData) {
+                return setColumn(getColumnIndex(columnName), colData);
             }
 
-            template<>
-            std::size_t SetColumn(const std::string &columnName, const std::vector<std::string>& colData) {
-                return SetColumn(getColumnIndex(columnName), colData);
+            // The cells are copied into the mesh buffer either way
+            std::size_t SetColumn(const size_t columnIndex, std::vector<std::string>&& colData) {
+                return setColumn(getColumnIndex(columnIndex), colData);
             }
 
-            template<>
             std::size_t SetColumn(const std::string &columnName, std::vector<std::string>&& colData) {
-                return SetColumn(getColumnIndex(columnName), std::forward<std::vector<std::string>>(colData));
+                return setColumn(getColumnIndex(columnName), colData);
             }
 
             // REMOVE
             std::size_t RemoveColumn(const size_t columnIndex) {
-                std::size_t realColumnIndex = getColumnIndex(columnIndex);
-
-                for (const auto& row : documentMesh) {
-                    row.erase(realColumnIndex);
-                }
-
-                return documentMesh.size();
+                return removeColumn(getColumnIndex(columnIndex));
             }
 
             std::size_t RemoveColumn(const std::string &columnName) {
-                return RemoveColumn(getColumnIndex(columnName));
+                return removeColumn(getColumnIndex(columnName));
             }
 
             //////////////////////////////////////////////////////////
@@ -159,51 +155,28 @@ namespace rapidcsv {
 
             // SET
             void SetRow(const size_t rowIndex, const std::vector<std::string> &row) {
-                using rapidcsv::read::enumerate;
-                using rapidcsv::read::wrapped;
-
-                MeshRow meshRow(row.size());
-                auto&& seq = enumerate(wrapped(row));
-                std::copy(std::make_move_iterator(std::begin(seq)),
-                          std::make_move_iterator(std::end(seq)), std::begin(meshRow));
-
-                documentMesh[getRowIndex(rowIndex)] = std::move(meshRow);
+                setRow(getRowIndex(rowIndex), row);
             }
 
             void SetRow(const size_t rowIndex, std::vector<std::string> &&row) {
-                using rapidcsv::read::enumerate;
-                using rapidcsv::read::wrapped;
-
-                MeshRow meshRow(row.size());
-                auto&& seq = enumerate(wrapped(std::forward<std::vector<std::string>>(std::move(row))));
-                std::copy(std::make_move_iterator(std::begin(seq)),
-                          std::make_move_iterator(std::end(seq)), std::begin(meshRow));
-
-                documentMesh[getRowIndex(rowIndex)] = std::move(meshRow);
+                setRow(getRowIndex(rowIndex), row);
             }
 
             void SetRow(const std::string& rowName, const std::vector<std::string> &row) {
-                SetRow(getRowIndex(rowName), row);
+                setRow(getRowIndex(rowName), row);
             }
 
             void SetRow(const std::string& rowName, std::vector<std::string> &&row) {
-                SetRow(getRowIndex(rowName), std::forward<std::vector<std::string>>(row));
+                setRow(getRowIndex(rowName), row);
             }
 
-            std::vector<std::string> RemoveRow (const size_t rowIndex) {
-                const normalizedIndex = getRowIndex(rowIndex);
-                MeshRow& meshRow = documentMesh[normalizedIndex];
-
-                std::vector<std::string> rowData(meshRow.size());
-                std::transform(std::make_move_iterator(std::begin(meshRow)),
-                               std::make_move_iterator(std::end(meshRow)),
-                               std::begin(rowData), std::get<1>);
-
-                return rowData;
+            // REMOVE
+            std::vector<std::string> RemoveRow(const size_t rowIndex) {
+                return removeRow(getRowIndex(rowIndex));
             }
 
             std::vector<std::string> RemoveRow(const std::string &rowName) {
-                return RemoveRow(getRowIndex(rowName));
+                return removeRow(getRowIndex(rowName));
             }
 
             //////////////////////////////////////////////////////////
@@ -211,45 +184,30 @@ namespace rapidcsv {
             //////////////////////////////////////////////////////////
 
             // GET
-            template<>
-            std::string GetCell(const std::size_t rowIndex, const std::size_t columnIndex) const {
-                auto normalizedRowIndex = getRowIndex(rowIndex);
-                auto normalizedColumnIndex = getColumnIndex(columnIndex);
-                return documentMesh[normalizedRowIndex][normalizedColumnIndex];
+            std::string GetCell(const std::size_t &rowIndex, const std::size_t &columnIndex) const {
+                return cell(getRowIndex(rowIndex), getColumnIndex(columnIndex));
             }
 
-            template<>
             std::string GetCell(const std::string &rowName, const std::string &columnName) const {
-                return GetCell(getRowIndex(rowName), getColumnIndex(columnName));
+                return cell(getRowIndex(rowName), getColumnIndex(columnName));
             }
 
             // SET
-            template<>
             void SetCell(const std::size_t rowIndex, const std::size_t columnIndex, const std::string& value) {
-                auto normalizedRowIndex = getRowIndex(rowIndex);
-                auto normalizedColumnIndex = getColumnIndex(columnIndex);
-                documentMesh[normalizedRowIndex][normalizedColumnIndex] = value;
+                setCell(getRowIndex(rowIndex), getColumnIndex(columnIndex), value);
             }
 
-            template<>
             void SetCell(const std::string &rowName, const std::string &columnName, const std::string& value) {
-                SetCell(getRowIndex(rowName), getColumnIndex(columnName), value);
+                setCell(getRowIndex(rowName), getColumnIndex(columnName), value);
             }
 
             // REMOVE
             std::string RemoveCell(const std::size_t rowIndex, const std::size_t columnIndex) {
-                auto normalizedRowIndex = getRowIndex(rowIndex);
-                auto normalizedColumnIndex = getColumnIndex(columnIndex);
-
-                MeshRow& row = documentMesh[normalizedRowIndex];
-                auto cellValue = std::move(row[normalizedColumnIndex]);
-                row.erase(normalizedColumnIndex);
-
-                return cellValue;
+                return removeCell(getRowIndex(rowIndex), getColumnIndex(columnIndex));
             }
 
             std::string RemoveCell(const std::string &rowName, const std::string &columnName) {
-                return RemoveCell(getRowIndex(rowName), getColumnIndex(columnName));
+                return removeCell(getRowIndex(rowName), getColumnIndex(columnName));
             }
 
             //////////////////////////////////////////////////////////
@@ -258,76 +216,93 @@ namespace rapidcsv {
 
             // SET
             void SetColumnLabel(const std::string &columnLabel, const std::string &newColumnLabel) {
-                auto normalizedColumnIndex = getColumnIndex(columnLabel);
+                const std::size_t realColumnIndex = getColumnIndex(columnLabel);
 
-                documentMesh[0][normalizedColumnIndex] = newColumnLabel;
+                documentMesh.set(0, realColumnIndex, newColumnLabel);
+                if (realColumnIndex - labelColumns() < documentSchema.size()) {
+                    documentSchema.rename(realColumnIndex - labelColumns(), newColumnLabel);
+                }
 
                 columnNames.erase(columnLabel);
-                columnNames[newColumnLabel] = normalizedColumnIndex;
+                columnNames[newColumnLabel] = realColumnIndex;
             }
 
             // GET
-            std::string GetColumnLabel(std::size_t columnIndex) {
-                auto normalizedColumnIndex = getColumnIndex(columnIndex);
-                return documentMesh[0][normalizedColumnIndex];
+            std::string GetColumnLabel(std::size_t columnIndex) const {
+                if (!documentProperties.hasHeader()) {
+                    throw std::out_of_range("Document has no column labels");
+                }
+                return cell(0, getColumnIndex(columnIndex));
+            }
+
+            std::string GetRowLabel(std::size_t rowIndex) const {
+                if (!documentProperties.hasRowLabel()) {
+                    throw std::out_of_range("Document has no row labels");
+                }
+                return cell(getRowIndex(rowIndex), 0);
             }
 
             //////////////////////////////////////////////////////////
             //////////////////////// SIZING //////////////////////////
             //////////////////////////////////////////////////////////
-            std::size_t rowCount(const std::size_t rowIndex) const {
-                auto normalizedRowIndex = getRowIndex(rowIndex);
-                return documentMesh[normalizedRowIndex].size();
-            }
 
-            std::size_t rowCount(const std::string& rowName) const {
-                return rowCount(getRowIndex(rowName));
+            // Number of rows, without the header
+            std::size_t size() const {
+                return documentMesh.size() - std::min(dataStart(), documentMesh.size());
             }
 
-            std::size_t maxRowCount() const {
-                return _rowCount;
+            // Number of cells of the widest row
+            std::size_t max_size() const {
+                std::size_t widest = 0;
+                for (std::size_t row = dataStart(); row < documentMesh.size(); ++row) {
+                    widest = std::max(widest, documentMesh.columns(row));
+                }
+                return widest;
             }
 
-            std::size_t columnCount() const {
-                return _columnCount;
+            std::size_t column_count(const std::size_t rowIndex) const {
+                return documentMesh.columns(getRowIndex(rowIndex));
             }
 
-        private:
-            rapidcsv::read::Reader<std::string> _GetColumn(const size_t columnIndex) const {
-                using rapidcsv::read::simpleReader;
-                using rapidcsv::read::transform_if;
-                using rapidcsv::read::r_transform;
+            std::size_t column_count(const std::string &rowName) const {
+                return documentMesh.columns(getRowIndex(rowName));
+            }
 
-                auto begin = (documentProperties.hasHeader() ? std::next(std::begin(documentMesh))
-                                                             : std::begin(documentMesh));
-                auto end = std::end(documentMesh);
+            //////////////////////////////////////////////////////////
+            /////////////////////// MAPPING //////////////////////////
+            //////////////////////////////////////////////////////////
 
-                auto reader = std::move(transform_if(simpleReader(begin, end), [&columnIndex](const MeshRow &row) {
-                    auto finder = row.find(columnIndex);
-                    return finder != std::end(row) ? std::make_pair(true, finder->second)
-                                                   : std::make_pair(false, "");
-                }, &std::get<0>));
+            // The file mapping kept alive for this document, when loaded with LoadMode::MMAP and keepMapping().
+            // The cells not edited since refer to its bytes
+            std::shared_ptr<const rapidcsv::read::MappedFile> mapping() const {
+                return documentMapping;
+            }
 
-                return r_transform(std::forward<std::decay<decltype(reader)>::type>(reader), [](std::pair<bool, std::string>&& data) {
-                    return std::get<1>(std::forward<std::decay<decltype(data)>::type>(data));
-                });
+            // The malformed rows dropped while loading with ErrorPolicy::COLLECT
+            const rapidcsv::read::Diagnostics &diagnostics() const {
+                return documentDiagnostics;
             }
 
-            template<typename T>
-            std::vector<T> _GetColumn(const size_t columnIndex, const T& fillValue) const {
-                using Interim = std::pair<bool, std::string>;
+            //////////////////////////////////////////////////////////
+            //////////////////////// SCHEMA //////////////////////////
+            //////////////////////////////////////////////////////////
 
-                std::vector<T> column;
-                auto begin = (documentProperties.hasHeader() ? std::next(std::begin(documentMesh))
-                                                             : std::begin(documentMesh));
-                auto end = std::end(documentMesh);
+            Schema schema() const override {
+                return documentSchema;
+            }
 
-                std::transform(begin, end, std::back_inserter(column), [&columnIndex, &fillValue](const MeshRow &row) {
-                    auto finder = row.find(columnIndex);
-                    return finder != std::end(row) ? convert::convert_to_val<T>(finder->second): fillValue;
-                });
+        private:
+            std::size_t labelColumns() const {
+                return documentProperties.hasRowLabel() ? 1 : 0;
+            }
 
-                return column;
+            // Index in the mesh of the first row that isn't the header
+            std::size_t dataStart() const {
+                return documentProperties.hasHeader() ? 1 : 0;
+            }
+
+            inline std::size_t getColumnIndex(const std::size_t columnIndex) const {
+                return columnIndex + labelColumns();
             }
 
             inline std::size_t getColumnIndex(const std::string &columnName) const {
@@ -338,194 +313,469 @@ namespace rapidcsv {
                 return columnIter->second;
             }
 
-            std::vector<std::string> _GetRow(const std::size_t rowIndex) const {
-                using rapidcsv::read::sequence;
-                using rapidcsv::read::r_copy_if;
-                using Tup = std::tuple<std::size_t, std::size_t>;
+            inline std::size_t getRowIndex(const std::size_t rowIndex) const {
+                if (rowIndex >= size()) {
+                    throw std::out_of_range("Row index out of range " + std::to_string(rowIndex));
+                }
+                return rowIndex + dataStart();
+            }
 
-                MeshRow& row = documentMesh[rowIndex];
-                std::vector<std::string> data(row.size());
+            inline std::size_t getRowIndex(const std::string &rowName) const {
+                auto rowIter = rowNames.find(rowName);
+                if (rowIter == std::end(rowNames)) {
+                    throw std::out_of_range("Row label not found");
+                }
+                return rowIter->second;
+            }
 
-                for (auto&& seq : sequence(r_copy_if(sequence(), [&row](const std::size_t index) {
-                    return row.count(index) > 0;
-                }))) {
-                    data[std::get<0>(std::forward<Tup>(seq))] = row[std::get<1>(std::forward<Tup>(seq))];
+            // Header cells by their mesh column, the row label column left out
+            void indexColumns() {
+                columnNames.clear();
+                if (dataStart() == 0 || documentMesh.empty()) {
+                    return;
+                }
+                for (std::size_t column = labelColumns(); column < documentMesh.columns(0); ++column) {
+                    if (documentMesh.has(0, column)) {
+                        columnNames[documentMesh.str(0, column)] = column;
+                    }
                 }
+            }
 
-                return data;
+            // Row labels by their mesh row, rebuilt whenever rows move or a label changes
+            void indexRows() {
+                rowNames.clear();
+                if (labelColumns() == 0) {
+                    return;
+                }
+                for (std::size_t row = dataStart(); row < documentMesh.size(); ++row) {
+                    if (documentMesh.has(row, 0)) {
+                        rowNames[documentMesh.str(row, 0)] = row;
+                    }
+                }
             }
 
-            inline std::size_t getColumnIndex(const std::size_t columnIndex) const {
-                auto normalizedColumn = columnIndex + (documentProperties.hasRowLabel() ? 1 : 0);
-                if (columnIndex >= this->columnCount() || normalizedColumn >= columnCount()) {
-                    throw std::out_of_range(std::string("column out of range : ") + columnIndex);
+            // A missing cell is an error, as in LazyDocument
+            std::string cell(const std::size_t realRowIndex, const std::size_t realColumnIndex) const {
+                auto typed = documentColumns.find(realColumnIndex);
+                if (typed != std::end(documentColumns) && realRowIndex >= dataStart()) {
+                    return typed->second.str(realRowIndex - dataStart());
                 }
-                return normalizedColumn;
+                if (!documentMesh.has(realRowIndex, realColumnIndex)) {
+                    throw std::out_of_range("column out of range : " + std::to_string(realColumnIndex));
+                }
+                return documentMesh.str(realRowIndex, realColumnIndex);
             }
 
-            inline std::size_t getRowIndex(const std::string &rowName) const {
-                auto rowIter = rowNames.find(rowName);
-                if (rowIter == std::end(rowNames)) {
-                    throw std::out_of_range("Row label not found");
+            void setCell(const std::size_t realRowIndex, const std::size_t realColumnIndex, const std::string &value) {
+                auto typed = documentColumns.find(realColumnIndex);
+                if (typed != std::end(documentColumns) && realRowIndex >= dataStart()) {
+                    if (typed->second.set(realRowIndex - dataStart(), value)) {
+                        return;
+                    }
+                    // Not a number of the column's type any more
+                    demote(realColumnIndex);
+                }
+                documentMesh.set(realRowIndex, realColumnIndex, value);
+                if (realColumnIndex < labelColumns()) {
+                    indexRows();
                 }
-                return rowIter->second;
             }
 
-            inline std::size_t getRowIndex(const std::size_t rowIndex) const {
-                auto normalizedRow = rowIndex + (documentProperties.hasHeader() ? 1 : 0);
-                if (rowIndex >= maxRowCount() || normalizedRow >= maxRowCount()) {
-                    throw std::out_of_range(std::string("Row index out of range ") + rowIndex);
+            std::string removeCell(const std::size_t realRowIndex, const std::size_t realColumnIndex) {
+                const std::string value = cell(realRowIndex, realColumnIndex);
+                demote(realColumnIndex);
+                documentMesh.erase(realRowIndex, realColumnIndex);
+                if (realColumnIndex < labelColumns()) {
+                    indexRows();
                 }
-                return normalizedRow;
+                return value;
             }
 
-            template <typename F, typename T, typename Cvt>
-            inline static std::vector<T> reader_to_vector(rapidcsv::read::Reader<F>&& reader, Cvt cvt) {
-                std::vector<T> vec;
-                std::transform(std::make_move_iterator(std::begin(reader)),
-                               std::make_move_iterator(std::end(reader)),
-                               std::back_inserter(vec), cvt);
+            std::size_t setColumn(const std::size_t realColumnIndex, const std::vector<std::string> &colData) {
+                demote(realColumnIndex);
+                documentMesh.set_column(realColumnIndex, colData, dataStart());
+                if (realColumnIndex < labelColumns()) {
+                    indexRows();
+                }
+                return size();
+            }
+
+            // The column keeps its index, every cell of it absent
+            std::size_t removeColumn(const std::size_t realColumnIndex) {
+                demote(realColumnIndex);
+                documentMesh.erase_column(realColumnIndex);
+                indexColumns();
+                if (realColumnIndex < labelColumns()) {
+                    indexRows();
+                }
+                return size();
+            }
 
-                return vec;
+            void setRow(const std::size_t realRowIndex, const std::vector<std::string> &row) {
+                demoteAll();
+                documentMesh.set_row(realRowIndex, row);
+                indexRows();
             }
 
-        private:
-            std::vector<MeshRow> documentMesh;
+            // The rows after it move up
+            std::vector<std::string> removeRow(const std::size_t realRowIndex) {
+                demoteAll();
+                std::vector<std::string> rowData = documentMesh.row(realRowIndex);
+                documentMesh.erase_row(realRowIndex);
+                indexRows();
+                return rowData;
+            }
+
+            // Views of the cells of a column, rows without it are skipped
+            std::vector<rapidcsv::read::FieldView> _GetColumnViews(const size_t columnIndex) const {
+                return documentMesh.column(columnIndex, dataStart());
+            }
+
+            template<typename T>
+            std::vector<T> _GetColumn(const size_t columnIndex, rapidcsv::convert::FailureBitmap &failures) const {
+                auto typed = documentColumns.find(columnIndex);
+                if (typed != std::end(documentColumns)) {
+                    std::vector<std::string> text;
+                    text.reserve(typed->second.size());
+                    for (std::size_t row = 0; row < typed->second.size(); ++row) {
+                        text.push_back(typed->second.str(row));
+                    }
+                    const std::vector<rapidcsv::read::FieldView> views(text.begin(), text.end());
+                    return rapidcsv::convert::convert_column<T>(views, failures);
+                }
+                return rapidcsv::convert::convert_column<T>(_GetColumnViews(columnIndex), failures);
+            }
+
+            // Columns held as numbers are copied, others are converted in one batch, or cell by cell
+            template<typename T, typename std::enable_if<rapidcsv::convert::is_batch_convertible<T>::value>::type * = nullptr>
+            std::vector<T> column_to_vector(const size_t columnIndex) const {
+                auto typed = documentColumns.find(columnIndex);
+                if (typed != std::end(documentColumns)) {
+                    // Other types are converted from the text, clamped as convert_to_val() does
+                    return typed->second.stored_as<T>() ? typed->second.values<T>()
+                                                        : typed_to_vector<T>(typed->second);
+                }
+                rapidcsv::convert::FailureBitmap failures;
+                return rapidcsv::convert::convert_column<T>(_GetColumnViews(columnIndex), failures);
+            }
+
+            template<typename T, typename std::enable_if<!rapidcsv::convert::is_batch_convertible<T>::value>::type * = nullptr>
+            std::vector<T> column_to_vector(const size_t columnIndex) const {
+                auto typed = documentColumns.find(columnIndex);
+                if (typed != std::end(documentColumns)) {
+                    return typed_to_vector<T>(typed->second);
+                }
+                std::vector<T> values;
+                for (const auto &cell : _GetColumnViews(columnIndex)) {
+                    values.push_back(rapidcsv::convert::convert_to_val<T>(cell.str()));
+                }
+                return values;
+            }
+
+            template<typename T>
+            static std::vector<T> typed_to_vector(const TypedColumn &column) {
+                std::vector<T> values;
+                values.reserve(column.size());
+                for (std::size_t row = 0; row < column.size(); ++row) {
+                    values.push_back(rapidcsv::convert::convert_to_val<T>(column.str(row)));
+                }
+                return values;
+            }
+
+            template<typename T>
+            std::vector<T> _GetColumn(const size_t columnIndex, const T& fillValue) const {
+                // Columns held as numbers have every cell
+                auto typed = documentColumns.find(columnIndex);
+                if (typed != std::end(documentColumns)) {
+                    return typed_to_vector<T>(typed->second);
+                }
+
+                std::vector<T> column;
+                column.reserve(size());
+                for (std::size_t row = dataStart(); row < documentMesh.size(); ++row) {
+                    column.push_back(documentMesh.has(row, columnIndex)
+                                     ? convert::convert_to_val<T>(documentMesh.str(row, columnIndex)) : fillValue);
+                }
+
+                return column;
+            }
+
+            std::vector<std::string> _GetRow(const std::size_t rowIndex) const {
+                std::vector<std::string> data = documentMesh.row(rowIndex);
+
+                // Cells of the columns held as numbers
+                for (const auto &typed : documentColumns) {
+                    if (rowIndex >= dataStart()) {
+                        if (typed.first >= data.size()) {
+                            data.resize(typed.first + 1);
+                        }
+                        data[typed.first] = typed.second.str(rowIndex - dataStart());
+                    }
+                }
+
+                return data;
+            }
+
+            // Picks a type per column from up to `sampleRows` data rows spread evenly over the document,
+            // then moves the INT64, DOUBLE and DATE columns out of the mesh. Such a column is left as STRING
+            // when a row lacks it, or a cell outside the sample doesn't fit its type
+            void inferSchema(const std::size_t sampleRows) {
+                const std::size_t first = dataStart();
+                const std::size_t rows = size();
+                const std::size_t step = sampleRows > 0 && rows > sampleRows ? rows / sampleRows : 1;
+
+                std::vector<TypeInferrer> inferrers;
+                if (first > 0 && !documentMesh.empty()) {
+                    inferrers.resize(documentMesh.columns(0));
+                }
+                for (std::size_t row = first; row < documentMesh.size(); row += step) {
+                    inferrers.resize(std::max(inferrers.size(), documentMesh.columns(row)));
+                    for (std::size_t column = 0; column < documentMesh.columns(row); ++column) {
+                        if (documentMesh.has(row, column)) {
+                            inferrers[column].add(documentMesh.cell(row, column));
+                        }
+                    }
+                }
+
+                documentSchema = Schema();
+                bool stored = false;
+                for (std::size_t column = labelColumns(); column < inferrers.size(); ++column) {
+                    ColumnType type = inferrers[column].type();
+                    if (TypedColumn::is_stored(type)) {
+                        if (storeColumn(column, type)) {
+                            stored = true;
+                        } else {
+                            type = ColumnType::STRING;
+                        }
+                    }
+                    documentSchema.add(first > 0 && !documentMesh.empty() ? documentMesh.str(0, column) : "", type);
+                }
+                // The text of the stored columns is no longer needed
+                if (stored) {
+                    documentMesh.compact();
+                }
+            }
+
+            bool storeColumn(const std::size_t columnIndex, const ColumnType type) {
+                // Every data row has to have the column
+                const std::vector<rapidcsv::read::FieldView> cells = documentMesh.column(columnIndex, dataStart());
+                if (cells.size() != size()) {
+                    return false;
+                }
+
+                TypedColumn column(type);
+                if (!column.assign(cells)) {
+                    return false;
+                }
+                for (std::size_t row = dataStart(); row < documentMesh.size(); ++row) {
+                    documentMesh.erase(row, columnIndex);
+                }
+                documentColumns.emplace(columnIndex, std::move(column));
+                return true;
+            }
+
+            // Moves a column held as numbers back into the mesh as strings
+            void demote(const std::size_t columnIndex) {
+                auto typed = documentColumns.find(columnIndex);
+                if (typed == std::end(documentColumns)) {
+                    return;
+                }
+                std::vector<std::string> cells;
+                cells.reserve(typed->second.size());
+                for (std::size_t row = 0; row < typed->second.size(); ++row) {
+                    cells.push_back(typed->second.str(row));
+                }
+                documentMesh.set_column(columnIndex, cells, dataStart());
+                documentColumns.erase(typed);
+                documentSchema.set(columnIndex - labelColumns(), ColumnType::STRING);
+            }
+
+            void demoteAll() {
+                while (!documentColumns.empty()) {
+                    demote(std::begin(documentColumns)->first);
+                }
+            }
+
+            // Cells by row or by column, see Properties::storageMode()
+            Mesh documentMesh;
             std::unordered_map<std::string, std::size_t> columnNames;
             std::unordered_map<std::string, std::size_t> rowNames;
-            std::size_t _rowCount = 0;
-            std::size_t _columnCount = 0;
-        };
-
-        class Document::Impl: public CSVDocument {
-            using CSVDocument::CSVDocument;
+            std::shared_ptr<const rapidcsv::read::MappedFile> documentMapping;
+            rapidcsv::read::Diagnostics documentDiagnostics;
+            Schema documentSchema;
+            // Columns held as numbers, by mesh column index. Their cells are not in the mesh
+            std::unordered_map<std::size_t, TypedColumn> documentColumns;
         };
     }
 }
 
 namespace rapidcsv {
-    void save(const doc::CSVDocument& document) {
-        using rapidcsv::operators::to_string;
-        using rapidcsv::read::wrapped;
-        using rapidcsv::read::zipped;
-
-        std::ofstream file(path, std::ios::out | std::ios::binary);
-        if (documentProperties.hasHeader()) {
-            std::vector<std::string> header(columnNames.size());
-
-            std::transform(std::begin(columnNames), std::end(columnNames), std::begin(header), [](const Title& title) {
-                return title.first;
-            });
+    namespace doc {
+        // A cell as written to a file. The readers keep the quotes around a quoted field and undo the
+        // doubling of the quotes inside it, which is redone here; other cells are quoted when they
+        // hold the separator, the quote or a line break
+        inline std::string to_csv_cell(const std::string &cell, char sep, char quote) {
+            const bool quoted = cell.size() >= 2 && cell.front() == quote && cell.back() == quote;
+            if (!quoted && cell.find_first_of(std::string{sep, quote, CR, LF}) == std::string::npos) {
+                return cell;
+            }
+            const std::size_t first = quoted ? 1 : 0, last = quoted ? cell.size() - 1 : cell.size();
+            std::string written(1, quote);
+            for (std::size_t at = first; at < last; ++at) {
+                if (cell[at] == quote) {
+                    written += quote;
+                }
+                written += cell[at];
+            }
+            return written += quote;
+        }
 
-            if (documentProperties.hasRowLabel() && !(columnNames.empty() || documentMesh.empty())) {
-                file << documentProperties.fieldSep();
+        // Parses a mapped file into a mesh whose cells refer to the mapping wherever they are its bytes
+        // as they are, see DenseMesh::push_back(row, offsets)
+        struct LoadMapped {
+            const read::MappedFile &mapping;
+            Mesh &mesh;
+            const Properties &properties;
+            read::Diagnostics *diagnostics;
+            const read::Projection &projection;
+            const read::RowFilter &filter;
+
+            template <typename Dialect>
+            void operator()(Dialect dialect) const {
+                read::DialectRowReader<Dialect> reader(read::blockReader(mapping.begin(), mapping.end()), dialect,
+                                                       properties.errorPolicy(), diagnostics, projection, filter);
+                mesh.source(mapping.begin(), mapping.size());
+                read::VS row;
+                while (reader.has_next()) {
+                    reader.next_into(row);
+                    mesh.push_back(row, reader.offsets());
+                }
             }
+        };
+    }
 
-            file << to_csv_row(std::begin(header), std::end(header),
-                               [&columnNames](const std::string& value) { return columnNames[value]; })
-                 << to_string(documentProperties.rowSep());
+    // Writes every row, the header and the row labels included, with the document's separators
+    inline void save(const doc::CSVDocument &document, const std::string &path) {
+        using rapidcsv::operators::to_string;
+        const Properties &properties = document.documentProperties;
+
+        // Cells may refer to the mapping of the very file being written, so the file is replaced only once
+        // written in full. The mapping keeps the bytes of the old one
+        const bool replace = static_cast<bool>(document.documentMapping);
+        const std::string written = replace ? path + ".tmp" : path;
+        {
+            std::ofstream file(written, std::ios::out | std::ios::binary);
+            for (std::size_t row = 0; row < document.documentMesh.size(); ++row) {
+                const std::vector<std::string> cells = document._GetRow(row);
+                for (std::size_t column = 0; column < cells.size(); ++column) {
+                    if (column > 0) {
+                        file << properties.fieldSep();
+                    }
+                    file << doc::to_csv_cell(cells[column], properties.fieldSep(), properties.quote());
+                }
+                file << to_string(properties.rowSep());
+            }
+        }
+        if (replace && std::rename(written.c_str(), path.c_str()) != 0) {
+            std::remove(written.c_str());
+            throw std::runtime_error("Unable to replace file: " + path);
         }
-
-//    std::vector<std::string> rowsName(rowNames.size());
-//    std::transform(std::begin(rowNames), std::end(rowNames), std::begin(rowsName), [](const Title& title) {
-//        return title.first;
-//    });
-
-//    auto cmp = [&rowNames](const std::string& s1, const std::string& s2) {
-//        return rowNames[s1] < rowNames[s2];
-//    };
-//
-//    std::map<std::string, std::size_t, decltype(cmp)> rowsNames(cmp);
-//    rowsNames.insert(std::begin(rowNames), std::end(rowNames));
-//
-//    auto
-
-
-        std::transform(std::begin(documentMesh), std::end(documentMesh),
-                       std::ostream_iterator<std::string>(file, to_string(documentProperties.rowSep())),
-                       [](const MeshRow& row) {
-                           return to_csv_row()
-                       }
-        std::bind(&CSVDocument::toCsvRow, this));
     }
 
-    doc::Document load(const Properties &properties) {
-        using rapidcsv::read::wrapped;
-        using rapidcsv::read::enumerate;
-        using ParamType = std::tuple<std::size_t, std::string>;
-        std::ifstream file (properties.filePath(), std::ios::in | std::ios::binary);
-
-        auto reader =  r_transform(row_reader(file), [](std::vector<std::string>&& row) {
-            rapidcsv::doc::CSVDocument::MeshRow transformRow;
-
-            auto zip = enumerate(wrapped(row));
-
-            std::transform(std::make_move_iterator(std::begin(zip)),
-                           std::make_move_iterator(std::end(zip)), std::inserter(transformRow,
-                                                                                 std::begin(transformRow)),
-                           [](ParamType&& out) {
-                               return std::make_pair(
-                                       std::forward<std::size_t>(std::get<0>(std::forward<ParamType>(out))),
-                                       std::forward<std::string>(std::get<1>(std::forward<ParamType>(out))));
-                           }
-            );
-            return transformRow;
-        });
+    // Saves back to the file the document was loaded from
+    inline void save(const doc::CSVDocument &document) {
+        save(document, document.documentProperties.filePath());
     }
 
-    template <typename In, typename Pos>
-    std::string to_csv_row(In begin, In end, Pos func) {
-        std::ostringstream oss;
-        auto columnCount = columnCount();
+    inline doc::CSVDocument load(const Properties &properties) {
+        std::ifstream file;
+        std::shared_ptr<const read::MappedFile> mapping;
+        doc::Mesh mesh(properties.storageMode());
+        read::Diagnostics diagnostics;
 
-        for (auto i = 0; i < columnCount; i++) {
-            if (begin != end) {
-                if (func(*begin) == i) {
-                    oss << *begin++;
-                }
+        // Columns left out are tokenized but never stored, the row labels are always kept
+        std::vector<std::size_t> kept = properties.keptColumns();
+        if (properties.hasRowLabel() && (!kept.empty() || !properties.keptColumnNames().empty())) {
+            kept.push_back(0);
+        }
+        const read::Projection projection(std::move(kept), properties.keptColumnNames());
+        // Rejected rows are dropped by the reader, before a cell of theirs is stored
+        read::RowFilter filter = properties.rowFilter();
+        filter.header(properties.hasHeader());
+
+        if (properties.loadMode() == LoadMode::MMAP) {
+            mapping = read::mapFile(properties.filePath());
+        } else if (properties.parseThreads() != 1) {
+            // Splitting the input needs random access to all of it, so a threaded STREAM load maps the file
+            // as well. What can't be mapped, a pipe say, is streamed block by block on this thread
+            try {
+                mapping = read::mapFile(properties.filePath());
+            } catch (const read::csv_file_map_exception &) {
             }
+        }
+        if (!mapping) {
+            file.open(properties.filePath(), std::ios::in | std::ios::binary);
+        }
 
-            if (i < columnCount - 1) {
-                oss << documentProperties.fieldSep();
+        if (mapping && properties.keepMapping() && properties.loadMode() == LoadMode::MMAP) {
+            // Unedited cells refer to the mapping, which needs the input offset of every cell: the rows
+            // are read on this thread
+            read::visit_dialect(properties.fieldSep(), properties.quote(), properties.rowSep(),
+                                doc::LoadMapped{*mapping, mesh, properties, &diagnostics, projection, filter});
+        } else if (mapping && properties.parseThreads() != 1) {
+            // Each range's rows are stored and freed as soon as the ranges before it are in. Ranges are at
+            // least a block long
+            read::parallel_parse_ranges(mapping->begin(), mapping->end(), properties.fieldSep(), properties.quote(),
+                                        properties.rowSep(),
+                                        [&mesh](std::vector<read::VS> &&rows) {
+                                            for (const auto &row : rows) {
+                                                mesh.push_back(row);
+                                            }
+                                        },
+                                        properties.parseThreads(), properties.blockSize(),
+                                        properties.errorPolicy(), &diagnostics, projection, filter);
+        } else {
+            auto reader = read::rowReader(mapping ? read::blockReader(mapping->begin(), mapping->end())
+                                          : properties.prefetchBuffers() > 0
+                                            ? read::prefetchBlockReader(file, properties.blockSize(),
+                                                                        properties.prefetchBuffers())
+                                            : read::blockReader(file, properties.blockSize()),
+                                          properties.fieldSep(), properties.quote(), properties.rowSep(),
+                                          properties.errorPolicy(), &diagnostics, projection, filter);
+            while (reader->has_next()) {
+                mesh.push_back(reader->next());
             }
         }
 
-        return oss.str();
+        doc::CSVDocument document(std::move(mesh), properties);
+        document.documentDiagnostics = std::move(diagnostics);
+        if (properties.schemaSample() > 0) {
+            document.inferSchema(properties.schemaSample());
+        }
+        if (properties.keepMapping() && properties.loadMode() == LoadMode::MMAP) {
+            document.documentMapping = std::move(mapping);
+        }
+        return document;
     }
 
-    doc::Document load(const std::string& path) {
+    inline doc::CSVDocument load(const std::string &path) {
         return load(PropertiesBuilder().filePath(path));
     }
 
-    void save(const doc::CSVDocument& document, const std::string& path) {
-        PropertiesBuilder builder = document.documentProperties;
-        document.documentProperties = std::move(builder.filePath(path));
-        save(document);
-    }
-}
+    // Counts the rows and fields of the file without storing any of them, see read::DialectStatsScanner
+    inline read::ScanStats scan_stats(const std::string &path, const Properties &properties = Properties()) {
+        if (properties.loadMode() == LoadMode::MMAP) {
+            const auto mapping = read::mapFile(path);
+            return read::scanStats(mapping->begin(), mapping->end(), properties.fieldSep(), properties.quote(),
+                                   properties.rowSep());
+        }
 
-void rapidcsv::CSVDocument::load(const std::string& path) {
-    using rapidcsv::read::wrapped;
-    using rapidcsv::read::enumerate;
-    using ParamType = std::tuple<std::size_t, std::string>;
-    std::ifstream file (path, std::ios::in | std::ios::binary);
-
-    auto reader =  r_transform(row_reader(file), [](std::vector<std::string>&& row) {
-        MeshRow transformRow;
-
-        auto zip = enumerate(wrapped(row));
-
-        std::transform(std::make_move_iterator(std::begin(zip)),
-                       std::make_move_iterator(std::end(zip)), std::inserter(transformRow,
-                                                                             std::begin(transformRow)),
-                       [](ParamType&& out) {
-                           return std::make_pair(
-                                   std::forward<std::size_t>(std::get<0>(std::forward<ParamType>(out))),
-                                   std::forward<std::string>(std::get<1>(std::forward<ParamType>(out))));
-                       }
-        );
-        return transformRow;
-    });
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        auto source = properties.prefetchBuffers() > 0
+                      ? read::prefetchBlockReader(file, properties.blockSize(), properties.prefetchBuffers())
+                      : read::blockReader(file, properties.blockSize());
+        return read::scanStats(*source, properties.fieldSep(), properties.quote(), properties.rowSep());
+    }
 }
 
 #endif //RAPIDCSV_CSV_DOCUMENT_HPP
@@ -2,6 +2,8 @@
 #define RAPIDCSV_CSV_EXCEPT_HPP
 
 #include <exception>
+#include <stdexcept>
+#include <string>
 
 namespace rapidcsv {
     namespace except {
@@ -42,6 +44,11 @@ namespace rapidcsv {
                 return "The reader has run out of bytes!";
             }
         };
+
+        struct csv_file_map_exception: public std::runtime_error {
+            explicit csv_file_map_exception(const std::string& path):
+                    std::runtime_error("Unable to memory map file: " + path) { }
+        };
     }
 }
 
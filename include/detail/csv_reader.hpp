@@ -7,6 +7,7 @@
 #include <iterator>
 
 #include "reader/reader.hpp"
+#include "reader/block_reader.hpp"
 #include "reader/field_reader.hpp"
 #include "reader/row_reader.hpp"
 #include "reader/simple_reader.hpp"
@@ -23,13 +24,11 @@ namespace std {
 namespace rapidcsv {
     template <typename _StreamT>
     std::shared_ptr<read::Reader<std::string>> fieldReader(_StreamT begin, _StreamT end) {
-        return std::make_shared<read::CSVFieldReader<_StreamT>>(std::move(begin), std::move(end));
+        return std::make_shared<read::CSVFieldReader>(std::move(begin), std::move(end));
     }
 
-    auto row_reader(const std::istream& stream) -> read::Reader<std::vector<std::string>> {
-        return rapidcsv::read::CSVRowReader<std::istreambuf_iterator<char>>(
-                std::istreambuf_iterator<char>{stream.rdbuf()},
-                std::istreambuf_iterator<char>{});
+    inline auto row_reader(const std::istream& stream, std::size_t blockSize = bufLength) -> read::CSVRowReader {
+        return rapidcsv::read::CSVRowReader(read::blockReader(stream, blockSize));
     }
 
 //    auto row_reader(std::istream&& stream) -> read::Reader<std::vector<std::string>>&& {
@@ -0,0 +1,334 @@
+#ifndef RAPIDCSV_CELL_ARENA_HPP
+#define RAPIDCSV_CELL_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "detail/reader/field_view.hpp"
+
+namespace rapidcsv {
+    namespace doc {
+
+        // Where the bytes of one cell live in a CellArena
+        struct CellRef {
+            std::uint64_t offset;
+            std::uint32_t length;
+        };
+
+        // Bump allocator holding the bytes of many cells in a few large slabs. Cells are appended and
+        // never freed one by one: the whole arena goes at once, one deallocation per slab.
+        //
+        // Offsets are global, slab i covers [i * slabSize, (i + 1) * slabSize). A cell never straddles
+        // two slabs; one larger than a slab gets a slab of its own, spanning as many slab indices.
+        //
+        // Cells may also refer to bytes the arena doesn't own, the file mapping a document was loaded
+        // from, see source(). Those are read-only and cost no arena bytes; the owner of the source
+        // keeps it alive as long as the arena and its copies.
+        class CellArena {
+            struct Slab {
+                std::unique_ptr<char[]> bytes;
+                std::size_t size;
+            };
+
+            std::size_t _slabSize;
+            // The slab indices spanned by a large cell after its first are left empty
+            std::vector<Slab> _slabs;
+            std::uint64_t _used;
+            std::size_t _allocated;
+            const char *_source;
+            std::size_t _sourceSize;
+
+            // Offset bit of the cells referring to the source
+            static constexpr std::uint64_t sourced = std::uint64_t(1) << 63;
+
+        public:
+            static constexpr std::size_t defaultSlabSize = 1024 * 1024;
+
+            explicit CellArena(std::size_t slabSize = defaultSlabSize) :
+                    _slabSize(slabSize > 0 ? slabSize : 1), _used(0), _allocated(0), _source(nullptr),
+                    _sourceSize(0) {}
+
+            CellArena(CellArena &&) = default;
+            CellArena &operator=(CellArena &&) = default;
+
+            // Copies every slab, the offsets of the cells stay valid in the copy
+            CellArena(const CellArena &other) :
+                    _slabSize(other._slabSize), _used(other._used), _allocated(other._allocated),
+                    _source(other._source), _sourceSize(other._sourceSize) {
+                _slabs.reserve(other._slabs.size());
+                for (std::size_t index = 0; index < other._slabs.size(); ++index) {
+                    const Slab &slab = other._slabs[index];
+                    Slab copy{std::unique_ptr<char[]>(slab.bytes ? new char[slab.size] : nullptr), slab.size};
+                    if (slab.bytes) {
+                        const std::uint64_t start = static_cast<std::uint64_t>(index) * _slabSize;
+                        std::memcpy(copy.bytes.get(), slab.bytes.get(),
+                                    static_cast<std::size_t>(std::min<std::uint64_t>(slab.size, _used - start)));
+                    }
+                    _slabs.push_back(std::move(copy));
+                }
+            }
+
+            CellArena &operator=(const CellArena &other) {
+                if (this != &other) {
+                    *this = CellArena(other);
+                }
+                return *this;
+            }
+
+            CellRef append(const char *data, std::size_t size) {
+                if (size == 0) {
+                    return CellRef{0, 0};
+                }
+                if (size > UINT32_MAX) {
+                    throw std::length_error("Cell larger than 4GiB");
+                }
+
+                std::uint64_t start = _used;
+                const auto at = static_cast<std::size_t>(start % _slabSize);
+                if (at != 0 && size > _slabSize - at) {
+                    // Doesn't fit in what is left of the current slab
+                    start += _slabSize - at;
+                }
+
+                if (start % _slabSize == 0) {
+                    const std::size_t span = (size + _slabSize - 1) / _slabSize;
+                    const std::size_t bytes = span == 1 ? _slabSize : size;
+                    _slabs.push_back(Slab{std::unique_ptr<char[]>(new char[bytes]), bytes});
+                    for (std::size_t extra = 1; extra < span; ++extra) {
+                        _slabs.push_back(Slab{std::unique_ptr<char[]>(), 0});
+                    }
+                    _allocated += bytes;
+                    _used = start + (span == 1 ? size : span * _slabSize);
+                } else {
+                    _used = start + size;
+                }
+
+                std::memcpy(pointer(start), data, size);
+                return CellRef{start, static_cast<std::uint32_t>(size)};
+            }
+
+            CellRef append(const std::string &data) {
+                return append(data.data(), data.size());
+            }
+
+            // Bytes outside the arena that cells can refer to, see refer()
+            void source(const char *bytes, std::size_t size) {
+                _source = bytes;
+                _sourceSize = size;
+            }
+
+            // Same source as `other`
+            void source(const CellArena &other) {
+                source(other._source, other._sourceSize);
+            }
+
+            // Whether the source holds `size` bytes at `offset` equal to `data`
+            bool in_source(std::uint64_t offset, const char *data, std::size_t size) const {
+                return _source != nullptr && offset <= _sourceSize && size <= _sourceSize - offset &&
+                       std::memcmp(_source + offset, data, size) == 0;
+            }
+
+            // A cell of `size` bytes at `offset` in the source, nothing is copied
+            CellRef refer(std::uint64_t offset, std::size_t size) const {
+                if (size == 0) {
+                    return CellRef{0, 0};
+                }
+                if (size > UINT32_MAX) {
+                    throw std::length_error("Cell larger than 4GiB");
+                }
+                return CellRef{offset | sourced, static_cast<std::uint32_t>(size)};
+            }
+
+            // Whether a cell refers to the source rather than to arena bytes
+            static bool is_sourced(const CellRef &cell) {
+                return (cell.offset & sourced) != 0;
+            }
+
+            // Writes `size` bytes over the start of an arena cell at least that long
+            void overwrite(const CellRef &cell, const char *data, std::size_t size) {
+                if (size > 0) {
+                    std::memcpy(pointer(cell.offset), data, size);
+                }
+            }
+
+            // Makes room for the slabs `bytes` more bytes need, without allocating them yet
+            void reserve(std::size_t bytes) {
+                _slabs.reserve(_slabs.size() + bytes / _slabSize + 1);
+            }
+
+            std::size_t slab_size() const {
+                return _slabSize;
+            }
+
+            read::FieldView view(const CellRef &cell) const {
+                if (cell.length == 0) {
+                    return read::FieldView();
+                }
+                return read::FieldView(address(cell.offset), cell.length);
+            }
+
+            std::string str(const CellRef &cell) const {
+                return view(cell).str();
+            }
+
+            // Number of slabs allocated
+            std::size_t slabs() const {
+                std::size_t count = 0;
+                for (const auto &slab : _slabs) {
+                    count += slab.bytes ? 1 : 0;
+                }
+                return count;
+            }
+
+            // Bytes held by the slabs
+            std::size_t memory() const {
+                return _allocated + _slabs.capacity() * sizeof(Slab);
+            }
+
+            void clear() {
+                _slabs.clear();
+                _used = 0;
+                _allocated = 0;
+            }
+
+        private:
+            const char *address(std::uint64_t offset) const {
+                if (offset & sourced) {
+                    return _source + static_cast<std::size_t>(offset & ~sourced);
+                }
+                return pointer(offset);
+            }
+
+            char *pointer(std::uint64_t offset) const {
+                return _slabs[static_cast<std::size_t>(offset / _slabSize)].bytes.get() +
+                       static_cast<std::size_t>(offset % _slabSize);
+            }
+        };
+
+        // Rows of cells stored in a CellArena: the cells of row i are cells[rowStarts[i], rowStarts[i + 1]).
+        // Next to the cell bytes, a cell costs one CellRef, a row one index.
+        class ArenaMesh {
+            CellArena _arena;
+            std::vector<CellRef> _cells;
+            std::vector<std::size_t> _rowStarts;
+
+        public:
+            // A row of the mesh, valid as long as the mesh is
+            class RowRef {
+                const ArenaMesh *_mesh;
+                std::size_t _row;
+
+            public:
+                RowRef(const ArenaMesh *mesh, std::size_t row) : _mesh(mesh), _row(row) {}
+
+                std::size_t size() const {
+                    return _mesh->columns(_row);
+                }
+
+                bool empty() const {
+                    return size() == 0;
+                }
+
+                std::string operator[](std::size_t column) const {
+                    return view(column).str();
+                }
+
+                read::FieldView view(std::size_t column) const {
+                    return _mesh->cell(_row, column);
+                }
+
+                std::vector<std::string> str() const {
+                    std::vector<std::string> row;
+                    row.reserve(size());
+                    for (std::size_t column = 0; column < size(); ++column) {
+                        row.push_back((*this)[column]);
+                    }
+                    return row;
+                }
+            };
+
+            explicit ArenaMesh(std::size_t slabSize = CellArena::defaultSlabSize) :
+                    _arena(slabSize), _rowStarts(1, 0) {}
+
+            void push_back(const std::vector<std::string> &row) {
+                for (const auto &cell : row) {
+                    _cells.push_back(_arena.append(cell));
+                }
+                _rowStarts.push_back(_cells.size());
+            }
+
+            // Number of rows
+            std::size_t size() const {
+                return _rowStarts.size() - 1;
+            }
+
+            bool empty() const {
+                return size() == 0;
+            }
+
+            std::size_t columns(std::size_t row) const {
+                check(row);
+                return _rowStarts[row + 1] - _rowStarts[row];
+            }
+
+            read::FieldView cell(std::size_t row, std::size_t column) const {
+                if (column >= columns(row)) {
+                    throw std::out_of_range("column out of range : " + std::to_string(column));
+                }
+                return _arena.view(_cells[_rowStarts[row] + column]);
+            }
+
+            // Views of the cells of a column from `firstRow` on, rows too short to have it are skipped
+            std::vector<read::FieldView> column(std::size_t column, std::size_t firstRow = 0) const {
+                std::vector<read::FieldView> cells;
+                cells.reserve(size() > firstRow ? size() - firstRow : 0);
+                for (std::size_t row = firstRow; row < size(); ++row) {
+                    if (column < _rowStarts[row + 1] - _rowStarts[row]) {
+                        cells.push_back(_arena.view(_cells[_rowStarts[row] + column]));
+                    }
+                }
+                return cells;
+            }
+
+            RowRef operator[](std::size_t row) const {
+                check(row);
+                return RowRef(this, row);
+            }
+
+            const CellArena &arena() const {
+                return _arena;
+            }
+
+            // Bytes held by the cells, their references and the row starts
+            std::size_t memory() const {
+                return _arena.memory() + _cells.capacity() * sizeof(CellRef) +
+                       _rowStarts.capacity() * sizeof(std::size_t);
+            }
+
+            void shrink_to_fit() {
+                _cells.shrink_to_fit();
+                _rowStarts.shrink_to_fit();
+            }
+
+            void clear() {
+                _arena.clear();
+                _cells.clear();
+                _rowStarts.assign(1, 0);
+            }
+
+        private:
+            void check(std::size_t row) const {
+                if (row >= size()) {
+                    throw std::out_of_range("Row index out of range " + std::to_string(row));
+                }
+            }
+        };
+    }
+}
+
+#endif //RAPIDCSV_CELL_ARENA_HPP
@@ -0,0 +1,338 @@
+#ifndef RAPIDCSV_COLUMN_MESH_HPP
+#define RAPIDCSV_COLUMN_MESH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "cell_arena.hpp"
+#include "detail/reader/field_view.hpp"
+
+namespace rapidcsv {
+    namespace doc {
+
+        // The cells of a document column by column, with the same interface as DenseMesh. Each column
+        // has its own CellArena and one (offset, length) per row, so scanning, setting or removing a
+        // column touches that column's memory only. Ragged rows are kept as a length per row:
+        // the cells of a column past the end of a row are absent.
+        //
+        // Edited cells are written in place when they fit and appended to their column otherwise;
+        // compact() drops the bytes no cell refers to any more. Views returned by cell() and column()
+        // are invalidated by edits. As in a DenseMesh, cells pushed with their offset in a source()
+        // refer to it until edited.
+        class ColumnMesh {
+            // Slab size of each column's arena, smaller than a DenseMesh's as there is one per column
+            static constexpr std::size_t slabSize = 16 * 1024;
+
+            struct Column {
+                CellArena bytes = CellArena(slabSize);
+                std::vector<CellRef> cells;
+                // Bytes of `bytes` no cell refers to
+                std::size_t garbage = 0;
+            };
+
+            std::vector<Column> _columns;
+            std::vector<std::size_t> _rowLengths;
+            // Source of every column's arena
+            const char *_source = nullptr;
+            std::size_t _sourceSize = 0;
+
+        public:
+            // Length of an absent cell
+            static constexpr std::uint32_t absent = UINT32_MAX;
+
+            void push_back(const std::vector<std::string> &row) {
+                if (row.size() > _columns.size()) {
+                    addColumns(row.size());
+                }
+                for (std::size_t column = 0; column < _columns.size(); ++column) {
+                    Column &target = _columns[column];
+                    target.cells.push_back(column < row.size() ? append(target, row[column]) : CellRef{0, absent});
+                }
+                _rowLengths.push_back(row.size());
+            }
+
+            // Same as push_back(row), offsets[i] being where cell i was read in the source. Cells found
+            // there byte for byte refer to it, the others are copied
+            void push_back(const std::vector<std::string> &row, const std::vector<std::uint64_t> &offsets) {
+                if (row.size() > _columns.size()) {
+                    addColumns(row.size());
+                }
+                for (std::size_t column = 0; column < _columns.size(); ++column) {
+                    Column &target = _columns[column];
+                    if (column >= row.size()) {
+                        target.cells.push_back(CellRef{0, absent});
+                    } else if (column < offsets.size() && row[column].size() < absent &&
+                               target.bytes.in_source(offsets[column], row[column].data(), row[column].size())) {
+                        target.cells.push_back(target.bytes.refer(offsets[column], row[column].size()));
+                    } else {
+                        target.cells.push_back(append(target, row[column]));
+                    }
+                }
+                _rowLengths.push_back(row.size());
+            }
+
+            // Bytes the cells pushed with offsets may refer to. They must outlive the mesh and its copies
+            void source(const char *bytes, std::size_t size) {
+                _source = bytes;
+                _sourceSize = size;
+                for (Column &column : _columns) {
+                    column.bytes.source(bytes, size);
+                }
+            }
+
+            // `cells` and `bytes` are totals, spread evenly over the columns seen so far
+            void reserve(std::size_t rows, std::size_t cells, std::size_t bytes) {
+                _rowLengths.reserve(rows);
+                const std::size_t columns = _columns.empty() ? 1 : _columns.size();
+                if (_columns.empty() && rows > 0) {
+                    addColumns(cells / rows);
+                }
+                for (Column &column : _columns) {
+                    column.cells.reserve(rows);
+                    column.bytes.reserve(bytes / columns);
+                }
+            }
+
+            // Number of rows
+            std::size_t size() const {
+                return _rowLengths.size();
+            }
+
+            bool empty() const {
+                return _rowLengths.empty();
+            }
+
+            // Number of cell slots in a row, absent ones included
+            std::size_t columns(std::size_t row) const {
+                check(row);
+                return _rowLengths[row];
+            }
+
+            bool has(std::size_t row, std::size_t column) const {
+                return column < columns(row) && _columns[column].cells[row].length != absent;
+            }
+
+            // Absent cells, and cells past the end of the row, are empty
+            read::FieldView cell(std::size_t row, std::size_t column) const {
+                if (column >= columns(row)) {
+                    return read::FieldView();
+                }
+                return view(_columns[column], _columns[column].cells[row]);
+            }
+
+            std::string str(std::size_t row, std::size_t column) const {
+                return cell(row, column).str();
+            }
+
+            // Every slot of a row, absent cells as empty strings
+            std::vector<std::string> row(std::size_t row) const {
+                std::vector<std::string> cells;
+                cells.reserve(columns(row));
+                for (std::size_t column = 0; column < _rowLengths[row]; ++column) {
+                    cells.push_back(view(_columns[column], _columns[column].cells[row]).str());
+                }
+                return cells;
+            }
+
+            // Views of the cells of a column from `firstRow` on, rows without it are skipped
+            std::vector<read::FieldView> column(std::size_t column, std::size_t firstRow = 0) const {
+                std::vector<read::FieldView> cells;
+                if (column >= _columns.size()) {
+                    return cells;
+                }
+                const Column &source = _columns[column];
+                cells.reserve(size() > firstRow ? size() - firstRow : 0);
+                for (std::size_t row = firstRow; row < source.cells.size(); ++row) {
+                    if (source.cells[row].length != absent) {
+                        cells.push_back(view(source, source.cells[row]));
+                    }
+                }
+                return cells;
+            }
+
+            // Sets a cell, growing the row with absent cells when it is too short
+            void set(std::size_t row, std::size_t column, const std::string &value) {
+                if (column >= columns(row)) {
+                    if (column >= _columns.size()) {
+                        addColumns(column + 1);
+                    }
+                    _rowLengths[row] = column + 1;
+                }
+                Column &target = _columns[column];
+                CellRef &cell = target.cells[row];
+                if (cell.length != absent && value.size() <= cell.length && !CellArena::is_sourced(cell)) {
+                    target.bytes.overwrite(cell, value.data(), value.size());
+                    target.garbage += cell.length - value.size();
+                    cell.length = static_cast<std::uint32_t>(value.size());
+                    return;
+                }
+                release(target, cell);
+                cell = append(target, value);
+            }
+
+            // Marks a cell absent, the cells after it keep their column
+            void erase(std::size_t row, std::size_t column) {
+                if (column < columns(row)) {
+                    release(_columns[column], _columns[column].cells[row]);
+                }
+            }
+
+            // Sets the cell of a column in the rows from `firstRow` on, one row per value of `cells`. When
+            // that reaches the last row the column is written afresh into a buffer sized once
+            void set_column(std::size_t column, const std::vector<std::string> &cells, std::size_t firstRow = 0) {
+                if (firstRow + cells.size() < size()) {
+                    for (std::size_t row = firstRow; row < firstRow + cells.size(); ++row) {
+                        set(row, column, cells[row - firstRow]);
+                    }
+                    return;
+                }
+                if (column >= _columns.size()) {
+                    addColumns(column + 1);
+                }
+
+                const Column &current = _columns[column];
+                std::size_t bytes = 0;
+                for (std::size_t row = 0; row < size(); ++row) {
+                    const CellRef &cell = current.cells[row];
+                    bytes += row >= firstRow ? cells[row - firstRow].size() : cell.length == absent ? 0 : cell.length;
+                }
+                Column fresh;
+                fresh.bytes.reserve(bytes);
+                fresh.cells.reserve(size());
+                for (std::size_t row = 0; row < size(); ++row) {
+                    if (row < firstRow) {
+                        const CellRef &cell = current.cells[row];
+                        fresh.cells.push_back(cell.length == absent ? cell : append(fresh, view(current, cell).str()));
+                        continue;
+                    }
+                    fresh.cells.push_back(append(fresh, cells[row - firstRow]));
+                    if (column >= _rowLengths[row]) {
+                        _rowLengths[row] = column + 1;
+                    }
+                }
+                _columns[column] = std::move(fresh);
+            }
+
+            // Marks every cell of a column absent and frees its buffer
+            void erase_column(std::size_t column) {
+                if (column < _columns.size()) {
+                    Column cleared;
+                    cleared.cells.assign(size(), CellRef{0, absent});
+                    _columns[column] = std::move(cleared);
+                }
+            }
+
+            // Replaces every cell of a row
+            void set_row(std::size_t row, const std::vector<std::string> &cells) {
+                for (std::size_t column = 0; column < columns(row); ++column) {
+                    release(_columns[column], _columns[column].cells[row]);
+                }
+                if (cells.size() > _columns.size()) {
+                    addColumns(cells.size());
+                }
+                for (std::size_t column = 0; column < cells.size(); ++column) {
+                    _columns[column].cells[row] = append(_columns[column], cells[column]);
+                }
+                _rowLengths[row] = cells.size();
+            }
+
+            // Drops a row, the rows after it move up
+            void erase_row(std::size_t row) {
+                check(row);
+                for (Column &column : _columns) {
+                    release(column, column.cells[row]);
+                    column.cells.erase(column.cells.begin() + static_cast<std::ptrdiff_t>(row));
+                }
+                _rowLengths.erase(_rowLengths.begin() + static_cast<std::ptrdiff_t>(row));
+            }
+
+            // Rewrites the buffers without the bytes no cell refers to
+            void compact() {
+                for (Column &column : _columns) {
+                    if (column.garbage == 0) {
+                        continue;
+                    }
+                    CellArena bytes(slabSize);
+                    bytes.source(_source, _sourceSize);
+                    for (CellRef &cell : column.cells) {
+                        if (cell.length != absent && cell.length != 0 && !CellArena::is_sourced(cell)) {
+                            cell = bytes.append(column.bytes.view(cell).data, cell.length);
+                        }
+                    }
+                    column.bytes = std::move(bytes);
+                    column.garbage = 0;
+                }
+            }
+
+            // Bytes no cell refers to any more
+            std::size_t garbage() const {
+                std::size_t garbage = 0;
+                for (const Column &column : _columns) {
+                    garbage += column.garbage;
+                }
+                return garbage;
+            }
+
+            // Bytes held by the cells, their references and the row lengths
+            std::size_t memory() const {
+                std::size_t memory = _columns.capacity() * sizeof(Column) +
+                                     _rowLengths.capacity() * sizeof(std::size_t);
+                for (const Column &column : _columns) {
+                    memory += column.bytes.memory() + column.cells.capacity() * sizeof(CellRef);
+                }
+                return memory;
+            }
+
+            void shrink_to_fit() {
+                for (Column &column : _columns) {
+                    column.cells.shrink_to_fit();
+                }
+                _columns.shrink_to_fit();
+                _rowLengths.shrink_to_fit();
+            }
+
+            void clear() {
+                _columns.clear();
+                _rowLengths.clear();
+            }
+
+        private:
+            void check(std::size_t row) const {
+                if (row >= size()) {
+                    throw std::out_of_range("Row index out of range " + std::to_string(row));
+                }
+            }
+
+            // New columns are absent in every row so far
+            void addColumns(std::size_t count) {
+                _columns.resize(count);
+                for (Column &column : _columns) {
+                    column.cells.resize(size(), CellRef{0, absent});
+                    column.bytes.source(_source, _sourceSize);
+                }
+            }
+
+            static CellRef append(Column &column, const std::string &value) {
+                if (value.size() > UINT32_MAX - 1) {
+                    throw std::length_error("Cell larger than 4GiB");
+                }
+                return column.bytes.append(value);
+            }
+
+            static read::FieldView view(const Column &column, const CellRef &cell) {
+                return cell.length == absent ? read::FieldView() : column.bytes.view(cell);
+            }
+
+            static void release(Column &column, CellRef &cell) {
+                if (cell.length != absent && !CellArena::is_sourced(cell)) {
+                    column.garbage += cell.length;
+                }
+                cell = CellRef{0, absent};
+            }
+        };
+    }
+}
+
+#endif //RAPIDCSV_COLUMN_MESH_HPP
@@ -0,0 +1,294 @@
+#ifndef RAPIDCSV_DENSE_MESH_HPP
+#define RAPIDCSV_DENSE_MESH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "cell_arena.hpp"
+#include "detail/reader/field_view.hpp"
+
+namespace rapidcsv {
+    namespace doc {
+
+        // Rows of cells in compressed sparse row form: the bytes of every cell in the slabs of a
+        // CellArena, an (offset, length) per cell, and where the cells of each row start. The cells of
+        // row i are cells[rowStarts[i], rowStarts[i + 1]), so ragged rows only differ in length. Loading
+        // fills one slab after the other, nothing is moved when the document outgrows a slab.
+        //
+        // A removed cell keeps its slot, marked absent, so the cells after it keep their column. Edited
+        // cells are written in place when they fit and appended otherwise; compact() drops the bytes
+        // no cell refers to any more. Views returned by cell() and column() are invalidated by edits.
+        // Each cell costs 16 bytes plus its characters, against a hash node and a std::string in a
+        // row of unordered_map. Cells pushed with their offset in a source(), a kept file mapping,
+        // cost no characters until edited: they refer to the source, and an edit copies them.
+        class DenseMesh {
+            CellArena _arena;
+            std::vector<CellRef> _cells;
+            std::vector<std::size_t> _rowStarts;
+            // Bytes of the arena no cell refers to
+            std::size_t _garbage;
+
+        public:
+            // Length of an absent cell
+            static constexpr std::uint32_t absent = UINT32_MAX;
+
+            static constexpr std::size_t defaultSlabSize = 64 * 1024;
+
+            explicit DenseMesh(std::size_t slabSize = defaultSlabSize) :
+                    _arena(slabSize), _rowStarts(1, 0), _garbage(0) {}
+
+            void push_back(const std::vector<std::string> &row) {
+                for (const auto &cell : row) {
+                    _cells.push_back(append(cell.data(), cell.size()));
+                }
+                _rowStarts.push_back(_cells.size());
+            }
+
+            // Same as push_back(row), offsets[i] being where cell i was read in the source. Cells found
+            // there byte for byte refer to it, the others, unescaped ones say, are copied
+            void push_back(const std::vector<std::string> &row, const std::vector<std::uint64_t> &offsets) {
+                for (std::size_t column = 0; column < row.size(); ++column) {
+                    const std::string &cell = row[column];
+                    _cells.push_back(column < offsets.size() && cell.size() < absent &&
+                                     _arena.in_source(offsets[column], cell.data(), cell.size())
+                                     ? _arena.refer(offsets[column], cell.size())
+                                     : append(cell.data(), cell.size()));
+                }
+                _rowStarts.push_back(_cells.size());
+            }
+
+            // Bytes the cells pushed with offsets may refer to. They must outlive the mesh and its copies
+            void source(const char *bytes, std::size_t size) {
+                _arena.source(bytes, size);
+            }
+
+            void reserve(std::size_t rows, std::size_t cells, std::size_t bytes) {
+                _rowStarts.reserve(rows + 1);
+                _cells.reserve(cells);
+                _arena.reserve(bytes);
+            }
+
+            // Number of rows
+            std::size_t size() const {
+                return _rowStarts.size() - 1;
+            }
+
+            bool empty() const {
+                return size() == 0;
+            }
+
+            // Number of cell slots in a row, absent ones included
+            std::size_t columns(std::size_t row) const {
+                check(row);
+                return _rowStarts[row + 1] - _rowStarts[row];
+            }
+
+            bool has(std::size_t row, std::size_t column) const {
+                return column < columns(row) && _cells[_rowStarts[row] + column].length != absent;
+            }
+
+            // Absent cells, and cells past the end of the row, are empty
+            read::FieldView cell(std::size_t row, std::size_t column) const {
+                if (column >= columns(row)) {
+                    return read::FieldView();
+                }
+                return view(_cells[_rowStarts[row] + column]);
+            }
+
+            std::string str(std::size_t row, std::size_t column) const {
+                return cell(row, column).str();
+            }
+
+            // Every slot of a row, absent cells as empty strings
+            std::vector<std::string> row(std::size_t row) const {
+                std::vector<std::string> cells;
+                cells.reserve(columns(row));
+                for (std::size_t index = _rowStarts[row]; index < _rowStarts[row + 1]; ++index) {
+                    cells.push_back(view(_cells[index]).str());
+                }
+                return cells;
+            }
+
+            // Views of the cells of a column from `firstRow` on, rows without it are skipped
+            std::vector<read::FieldView> column(std::size_t column, std::size_t firstRow = 0) const {
+                std::vector<read::FieldView> cells;
+                cells.reserve(size() > firstRow ? size() - firstRow : 0);
+                for (std::size_t row = firstRow; row < size(); ++row) {
+                    if (has(row, column)) {
+                        cells.push_back(view(_cells[_rowStarts[row] + column]));
+                    }
+                }
+                return cells;
+            }
+
+            // Sets a cell, growing the row with absent cells when it is too short
+            void set(std::size_t row, std::size_t column, const std::string &value) {
+                if (column >= columns(row)) {
+                    resize(row, column + 1);
+                }
+                write(_cells[_rowStarts[row] + column], value);
+            }
+
+            // Marks a cell absent, the cells after it keep their column
+            void erase(std::size_t row, std::size_t column) {
+                if (column < columns(row)) {
+                    release(_cells[_rowStarts[row] + column]);
+                }
+            }
+
+            // Sets the cell of a column in the rows from `firstRow` on, one row per value of `cells`. Rows
+            // too short for the column are all grown in a single pass over the cells
+            void set_column(std::size_t column, const std::vector<std::string> &cells, std::size_t firstRow = 0) {
+                const std::size_t lastRow = firstRow + std::min(cells.size(), size() > firstRow ? size() - firstRow : 0);
+                std::size_t grown = 0;
+                for (std::size_t row = firstRow; row < lastRow; ++row) {
+                    grown += column >= columns(row) ? column + 1 - columns(row) : 0;
+                }
+                if (grown > 0) {
+                    std::vector<CellRef> rebuilt;
+                    rebuilt.reserve(_cells.size() + grown);
+                    for (std::size_t row = 0; row < size(); ++row) {
+                        const auto first = _cells.begin() + static_cast<std::ptrdiff_t>(_rowStarts[row]);
+                        const auto last = _cells.begin() + static_cast<std::ptrdiff_t>(_rowStarts[row + 1]);
+                        _rowStarts[row] = rebuilt.size();
+                        rebuilt.insert(rebuilt.end(), first, last);
+                        if (row >= firstRow && row < lastRow && column >= static_cast<std::size_t>(last - first)) {
+                            rebuilt.resize(_rowStarts[row] + column + 1, CellRef{0, absent});
+                        }
+                    }
+                    _rowStarts.back() = rebuilt.size();
+                    _cells.swap(rebuilt);
+                }
+                for (std::size_t row = firstRow; row < lastRow; ++row) {
+                    write(_cells[_rowStarts[row] + column], cells[row - firstRow]);
+                }
+            }
+
+            void erase_column(std::size_t column) {
+                for (std::size_t row = 0; row < size(); ++row) {
+                    erase(row, column);
+                }
+            }
+
+            // Replaces every cell of a row
+            void set_row(std::size_t row, const std::vector<std::string> &cells) {
+                const std::size_t first = _rowStarts[row];
+                const std::size_t count = columns(row);
+                for (std::size_t index = first; index < first + count; ++index) {
+                    release(_cells[index]);
+                }
+                resize(row, cells.size());
+                for (std::size_t column = 0; column < cells.size(); ++column) {
+                    _cells[first + column] = append(cells[column].data(), cells[column].size());
+                }
+            }
+
+            // Drops a row, the rows after it move up
+            void erase_row(std::size_t row) {
+                const std::size_t first = _rowStarts[row];
+                for (std::size_t index = first; index < _rowStarts[row + 1]; ++index) {
+                    release(_cells[index]);
+                }
+                resize(row, 0);
+                _rowStarts.erase(_rowStarts.begin() + static_cast<std::ptrdiff_t>(row) + 1);
+            }
+
+            // Copies the cells to a new arena, without the bytes no cell refers to
+            void compact() {
+                CellArena arena(_arena.slab_size());
+                arena.source(_arena);
+                for (CellRef &cell : _cells) {
+                    if (cell.length != absent && cell.length != 0 && !CellArena::is_sourced(cell)) {
+                        cell = arena.append(_arena.view(cell).data, cell.length);
+                    }
+                }
+                _arena = std::move(arena);
+                _garbage = 0;
+            }
+
+            // Bytes no cell refers to any more
+            std::size_t garbage() const {
+                return _garbage;
+            }
+
+            // Number of arena slabs holding the cell bytes
+            std::size_t slabs() const {
+                return _arena.slabs();
+            }
+
+            // Bytes held by the cells, their references and the row starts
+            std::size_t memory() const {
+                return _arena.memory() + _cells.capacity() * sizeof(CellRef) +
+                       _rowStarts.capacity() * sizeof(std::size_t);
+            }
+
+            void shrink_to_fit() {
+                _cells.shrink_to_fit();
+                _rowStarts.shrink_to_fit();
+            }
+
+            void clear() {
+                _arena.clear();
+                _cells.clear();
+                _rowStarts.assign(1, 0);
+                _garbage = 0;
+            }
+
+        private:
+            void check(std::size_t row) const {
+                if (row >= size()) {
+                    throw std::out_of_range("Row index out of range " + std::to_string(row));
+                }
+            }
+
+            CellRef append(const char *data, std::size_t size) {
+                if (size > UINT32_MAX - 1) {
+                    throw std::length_error("Cell larger than 4GiB");
+                }
+                return _arena.append(data, size);
+            }
+
+            read::FieldView view(const CellRef &cell) const {
+                return cell.length == absent ? read::FieldView() : _arena.view(cell);
+            }
+
+            // In place when the value fits, appended otherwise. The source is never written to
+            void write(CellRef &cell, const std::string &value) {
+                if (cell.length != absent && value.size() <= cell.length && !CellArena::is_sourced(cell)) {
+                    _arena.overwrite(cell, value.data(), value.size());
+                    _garbage += cell.length - value.size();
+                    cell.length = static_cast<std::uint32_t>(value.size());
+                    return;
+                }
+                release(cell);
+                cell = append(value.data(), value.size());
+            }
+
+            void release(CellRef &cell) {
+                if (cell.length != absent && !CellArena::is_sourced(cell)) {
+                    _garbage += cell.length;
+                }
+                cell = CellRef{0, absent};
+            }
+
+            // Makes room for `count` slots in a row, new ones absent, and moves the rows after it
+            void resize(std::size_t row, std::size_t count) {
+                const std::size_t current = columns(row);
+                const auto end = _cells.begin() + static_cast<std::ptrdiff_t>(_rowStarts[row + 1]);
+                if (count > current) {
+                    _cells.insert(end, count - current, CellRef{0, absent});
+                } else {
+                    _cells.erase(end - static_cast<std::ptrdiff_t>(current - count), end);
+                }
+                for (std::size_t next = row + 1; next < _rowStarts.size(); ++next) {
+                    _rowStarts[next] = _rowStarts[next] + count - current;
+                }
+            }
+        };
+    }
+}
+
+#endif //RAPIDCSV_DENSE_MESH_HPP
@@ -2,6 +2,7 @@
 #define RAPIDCSV_DOCUMENT_HPP
 
 #include <cstddef> // std::size_t
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <memory>
@@ -9,16 +10,13 @@
 #include <iterator>
 #include <unordered_map>
 #include "properties.hpp"
+#include "schema.hpp"
 #include "detail/csv_convert.hpp"
-#include "detail/util/fp.hpp"
 
 namespace rapidcsv {
     namespace doc {
         class Document {
-            using MeshRow = std::unordered_map<std::size_t, std::string>;
-            using Entry = MeshRow::value_type;
-
-        private:
+        protected:
             Properties documentProperties;
             Document(Properties properties): documentProperties(std::move(properties)) {}
 
@@ -37,7 +35,7 @@ namespace rapidcsv {
             template<typename T>
             std::vector<T> GetColumn(const std::size_t &columnIndex, const T& fillValue) const {
                 auto str_column = GetColumn(columnIndex, rapidcsv::convert::convert_to_string(fillValue));
-                std::vector<T> column{str_column.size()};
+                std::vector<T> column(str_column.size());
                 std::transform(std::make_move_iterator(std::begin(str_column)),
                                std::make_move_iterator(std::end(str_column)),
                                std::begin(column),
@@ -49,7 +47,7 @@ namespace rapidcsv {
             template<typename T>
             std::vector<T> GetColumn(const std::string &columnName, const T& fillValue) const {
                 auto str_column = GetColumn(columnName, rapidcsv::convert::convert_to_string<T>(fillValue));
-                std::vector<T> column{str_column.size()};
+                std::vector<T> column(str_column.size());
                 std::transform(std::make_move_iterator(std::begin(str_column)),
                                std::make_move_iterator(std::end(str_column)),
                                std::begin(column),
@@ -61,7 +59,7 @@ namespace rapidcsv {
             template<typename T>
             std::vector<T> GetColumn(const size_t columnIndex) const {
                 auto str_column = GetColumn(columnIndex);
-                std::vector<T> column{str_column.size()};
+                std::vector<T> column(str_column.size());
                 std::transform(std::make_move_iterator(std::begin(str_column)),
                                std::make_move_iterator(std::end(str_column)),
                                std::begin(column),
@@ -71,9 +69,9 @@ namespace rapidcsv {
             }
 
             template<typename T>
-            std::vector<T> GetColumn(const std::string columnName) const {
+            std::vector<T> GetColumn(const std::string &columnName) const {
                 auto str_column = GetColumn(columnName);
-                std::vector<T> column{str_column.size()};
+                std::vector<T> column(str_column.size());
                 std::transform(std::make_move_iterator(std::begin(str_column)),
                                std::make_move_iterator(std::end(str_column)),
                                std::begin(column),
@@ -168,12 +166,12 @@ namespace rapidcsv {
 
             template<typename T>
             void SetCell(const std::size_t rowIndex, const std::size_t columnIndex, const T& tVal) {
-                SetCell(columnIndex, rowIndex, rapidcsv::convert::convert_to_string(tVal));
+                SetCell(rowIndex, columnIndex, rapidcsv::convert::convert_to_string(tVal));
             }
 
             template<typename T>
             void SetCell(const std::string &rowName, const std::string &columnName, const T& tVal) {
-                SetCell(columnName, rowName, rapidcsv::convert::convert_to_string(tVal));
+                SetCell(rowName, columnName, rapidcsv::convert::convert_to_string(tVal));
             }
 
             // REMOVE
@@ -208,96 +206,16 @@ namespace rapidcsv {
 
             virtual std::size_t column_count(const std::string& row_name) const = 0;
 
-            virtual ~Document() {}
-
-        protected:
             //////////////////////////////////////////////////////////
-            ///////////////////////// INDEX //////////////////////////
+            //////////////////////// SCHEMA //////////////////////////
             //////////////////////////////////////////////////////////
 
-//            virtual std::size_t getColumnIndex(const std::string &columnName) const = 0;
-//            virtual std::size_t getColumnIndex(const std::size_t columnIndex) const = 0;
-//            virtual std::size_t getRowIndex(const std::string &rowName) const = 0;
-//            virtual std::size_t getRowIndex(const std::size_t rowIndex) const = 0;
-
-        private:
-            rapidcsv::read::Reader<std::string> _GetColumn(const size_t columnIndex) const {
-                using rapidcsv::read::simpleReader;
-                using rapidcsv::read::transform_if;
-                using rapidcsv::read::r_transform;
-
-                auto begin = (documentProperties.hasHeader() ? std::next(std::begin(documentMesh))
-                                                             : std::begin(documentMesh));
-                auto end = std::end(documentMesh);
-
-                auto reader = std::move(transform_if(simpleReader(begin, end), [&columnIndex](const MeshRow &row) {
-                    auto finder = row.find(columnIndex);
-                    return finder != std::end(row) ? std::make_pair(true, finder->second)
-                                                   : std::make_pair(false, "");
-                }, &std::get<0>));
-
-                return r_transform(std::forward<std::decay<decltype(reader)>::type>(reader), [](std::pair<bool, std::string>&& data) {
-                    return std::get<1>(std::forward<std::decay<decltype(data)>::type>(data));
-                });
-            }
-
-            std::vector<std::string> _GetRow(const std::size_t rowIndex) const {
-                using rapidcsv::read::sequence;
-                using rapidcsv::read::r_copy_if;
-                using Tup = std::tuple<std::size_t, std::size_t>;
-
-                MeshRow& row = documentMesh[rowIndex];
-                std::vector<std::string> data(row.size());
-
-                for (auto&& seq : sequence(r_copy_if(sequence(), [&row](const std::size_t index) {
-                    return row.count(index) > 0;
-                }))) {
-                    data[std::get<0>(std::forward<Tup>(seq))] = row[std::get<1>(std::forward<Tup>(seq))];
-                }
-
-                return data;
+            // Column types inferred while loading, see PropertiesBuilder::inferSchema(). Empty otherwise
+            virtual Schema schema() const {
+                return Schema();
             }
 
-            template <typename F, typename T, typename Cvt>
-            inline static std::vector<T> reader_to_vector(rapidcsv::read::Reader<F>&& reader, Cvt cvt) {
-                std::vector<T> vec;
-                std::transform(std::make_move_iterator(std::begin(reader)),
-                               std::make_move_iterator(std::end(reader)),
-                               std::back_inserter(vec), cvt);
-
-                return vec;
-            }
-
-            inline std::size_t getColumnIndex(const std::size_t columnIndex) const {
-                auto normalizedColumn = columnIndex + (documentProperties.hasRowLabel() ? 1 : 0);
-                if (columnIndex >= this->columnCount() || normalizedColumn >= columnCount()) {
-                    throw std::out_of_range(std::string("column out of range : ") + columnIndex);
-                }
-                return normalizedColumn;
-            }
-
-            inline std::size_t getRowIndex(const std::string &rowName) const {
-                auto rowIter = rowNames.find(rowName);
-                if (rowIter == std::end(rowNames)) {
-                    throw std::out_of_range("Row label not found");
-                }
-                return rowIter->second;
-            }
-
-            inline std::size_t getRowIndex(const std::size_t rowIndex) const {
-                auto normalizedRow = rowIndex + (documentProperties.hasHeader() ? 1 : 0);
-                if (rowIndex >= maxRowCount() || normalizedRow >= maxRowCount()) {
-                    throw std::out_of_range(std::string("Row index out of range ") + rowIndex);
-                }
-                return normalizedRow;
-            }
-
-        private:
-            std::vector<MeshRow> documentMesh;
-            std::unordered_map<std::string, std::size_t> columnNames;
-            std::unordered_map<std::string, std::size_t> rowNames;
-            std::size_t _rowCount = 0;
-            std::size_t _columnCount = 0;
+            virtual ~Document() {}
         };
     }
 }
@@ -0,0 +1,454 @@
+#ifndef RAPIDCSV_LAZY_DOCUMENT_HPP
+#define RAPIDCSV_LAZY_DOCUMENT_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "properties.hpp"
+#include "document.hpp"
+#include "detail/reader/row_index.hpp"
+#include "detail/reader/row_cache.hpp"
+
+namespace rapidcsv {
+    namespace doc {
+
+        // Document that only indexes the file when it is opened. Rows are parsed a block at a time
+        // the first time GetCell, GetRow or GetColumn reaches them and are kept in a cache bounded by
+        // Properties::cacheLimit(), least recently used blocks are dropped first.
+        //
+        // Edited rows are copied out of the cache and kept for the lifetime of the document, removed
+        // rows and columns are only recorded. Looking a row up by its label parses every row once.
+        class LazyDocument : public Document {
+            using MeshRow = std::unordered_map<std::size_t, std::string>;
+
+        public:
+            using Document::GetColumn;
+            using Document::SetColumn;
+            using Document::GetCell;
+            using Document::SetCell;
+            using Document::SetColumnLabel;
+            using Document::column_count;
+
+            explicit LazyDocument(Properties properties) :
+                    Document(std::move(properties)),
+                    documentCache(read::IndexedFile(documentProperties.filePath(),
+                                                    documentProperties.loadMode() == LoadMode::MMAP,
+                                                    read::IndexEncoding::DELTA, documentProperties.blockSize(),
+                                                    read::RuntimeDialect(documentProperties.fieldSep(),
+                                                                         documentProperties.quote(),
+                                                                         documentProperties.rowSep())),
+                                  documentProperties.cacheLimit()),
+                    rowNamesBuilt(false) {
+                if (documentProperties.hasHeader() && documentCache.size() > 0) {
+                    const auto &header = documentCache.row(0);
+                    for (std::size_t index = 0; index < header.size(); ++index) {
+                        columnNames[header[index]] = index;
+                    }
+                }
+            }
+
+            LazyDocument(LazyDocument &&) = default;
+
+            //////////////////////////////////////////////////////////
+            /////////////////////// COLUMNS //////////////////////////
+            //////////////////////////////////////////////////////////
+
+            // GET
+            std::vector<std::string> GetColumn(const std::string &columnName, const std::string &fillValue) const {
+                return column(getColumnIndex(columnName), &fillValue);
+            }
+
+            std::vector<std::string> GetColumn(const std::size_t &columnIndex, const std::string &fillValue) const {
+                return column(getColumnIndex(columnIndex), &fillValue);
+            }
+
+            std::vector<std::string> GetColumn(const std::string &columnName) const {
+                return column(getColumnIndex(columnName), nullptr);
+            }
+
+            std::vector<std::string> GetColumn(const std::size_t &columnIndex) const {
+                return column(getColumnIndex(columnIndex), nullptr);
+            }
+
+            // SET
+            std::size_t SetColumn(const size_t columnIndex, const std::vector<std::string> &colData) {
+                return setColumn(getColumnIndex(columnIndex), std::vector<std::string>(colData));
+            }
+
+            std::size_t SetColumn(const std::string &columnName, const std::vector<std::string> &colData) {
+                return setColumn(getColumnIndex(columnName), std::vector<std::string>(colData));
+            }
+
+            std::size_t SetColumn(const size_t columnIndex, std::vector<std::string> &&colData) {
+                return setColumn(getColumnIndex(columnIndex), std::move(colData));
+            }
+
+            std::size_t SetColumn(const std::string &columnName, std::vector<std::string> &&colData) {
+                return setColumn(getColumnIndex(columnName), std::move(colData));
+            }
+
+            // REMOVE
+            std::size_t RemoveColumn(const size_t columnIndex) {
+                return removeColumn(getColumnIndex(columnIndex));
+            }
+
+            std::size_t RemoveColumn(const std::string &columnName) {
+                return removeColumn(getColumnIndex(columnName));
+            }
+
+            //////////////////////////////////////////////////////////
+            ///////////////////////// ROWS ///////////////////////////
+            //////////////////////////////////////////////////////////
+
+            // GET
+            std::vector<std::string> GetRow(const size_t rowIndex) const {
+                return row(getRowIndex(rowIndex));
+            }
+
+            std::vector<std::string> GetRow(const std::string &rowName) const {
+                return row(getRowIndex(rowName));
+            }
+
+            // SET
+            void SetRow(const size_t rowIndex, const std::vector<std::string> &row) {
+                SetRow(rowIndex, std::vector<std::string>(row));
+            }
+
+            void SetRow(const size_t rowIndex, std::vector<std::string> &&row) {
+                setRow(getRowIndex(rowIndex), std::move(row));
+            }
+
+            void SetRow(const std::string &rowName, const std::vector<std::string> &row) {
+                SetRow(rowName, std::vector<std::string>(row));
+            }
+
+            void SetRow(const std::string &rowName, std::vector<std::string> &&row) {
+                setRow(getRowIndex(rowName), std::move(row));
+            }
+
+            // REMOVE
+            std::vector<std::string> RemoveRow(const size_t rowIndex) {
+                return removeRow(getRowIndex(rowIndex));
+            }
+
+            std::vector<std::string> RemoveRow(const std::string &rowName) {
+                return removeRow(getRowIndex(rowName));
+            }
+
+            //////////////////////////////////////////////////////////
+            //////////////////////// CELLS ///////////////////////////
+            //////////////////////////////////////////////////////////
+
+            // GET
+            std::string GetCell(const std::size_t &rowIndex, const std::size_t &columnIndex) const {
+                return cell(getRowIndex(rowIndex), getColumnIndex(columnIndex));
+            }
+
+            std::string GetCell(const std::string &rowName, const std::string &columnName) const {
+                return cell(getRowIndex(rowName), getColumnIndex(columnName));
+            }
+
+            // SET
+            void SetCell(const std::size_t rowIndex, const std::size_t columnIndex, const std::string &value) {
+                editable(getRowIndex(rowIndex))[getColumnIndex(columnIndex)] = value;
+                rowNamesBuilt = false;
+            }
+
+            void SetCell(const std::string &rowName, const std::string &columnName, const std::string &value) {
+                editable(getRowIndex(rowName))[getColumnIndex(columnName)] = value;
+                rowNamesBuilt = false;
+            }
+
+            // REMOVE
+            std::string RemoveCell(const std::size_t rowIndex, const std::size_t columnIndex) {
+                return removeCell(getRowIndex(rowIndex), getColumnIndex(columnIndex));
+            }
+
+            std::string RemoveCell(const std::string &rowName, const std::string &columnName) {
+                return removeCell(getRowIndex(rowName), getColumnIndex(columnName));
+            }
+
+            //////////////////////////////////////////////////////////
+            //////////////////////// LABELS //////////////////////////
+            //////////////////////////////////////////////////////////
+
+            // SET
+            void SetColumnLabel(const std::string &columnLabel, const std::string &newColumnLabel) {
+                const std::size_t realColumnIndex = getColumnIndex(columnLabel);
+
+                editable(0)[realColumnIndex] = newColumnLabel;
+
+                columnNames.erase(columnLabel);
+                columnNames[newColumnLabel] = realColumnIndex;
+            }
+
+            // GET
+            std::string GetColumnLabel(std::size_t columnIndex) const {
+                if (!documentProperties.hasHeader()) {
+                    throw std::out_of_range("Document has no column labels");
+                }
+                return cell(0, getColumnIndex(columnIndex));
+            }
+
+            std::string GetRowLabel(std::size_t rowIndex) const {
+                if (!documentProperties.hasRowLabel()) {
+                    throw std::out_of_range("Document has no row labels");
+                }
+                return cell(getRowIndex(rowIndex), 0);
+            }
+
+            //////////////////////////////////////////////////////////
+            //////////////////////// SIZING //////////////////////////
+            //////////////////////////////////////////////////////////
+
+            // Number of rows, without the header
+            std::size_t size() const {
+                return documentCache.size() - headerRows() - removedRows.size();
+            }
+
+            // Number of cells of the widest row, parses every row
+            std::size_t max_size() const {
+                std::size_t widest = 0;
+                for (std::size_t row = 0; row < size(); ++row) {
+                    widest = std::max(widest, this->row(getRowIndex(row)).size());
+                }
+                return widest;
+            }
+
+            std::size_t column_count(const std::string &rowName) const {
+                return row(getRowIndex(rowName)).size();
+            }
+
+            //////////////////////////////////////////////////////////
+            //////////////////////// CACHE ///////////////////////////
+            //////////////////////////////////////////////////////////
+
+            const read::RowCache &cache() const {
+                return documentCache;
+            }
+
+        private:
+            std::size_t headerRows() const {
+                return documentProperties.hasHeader() ? 1 : 0;
+            }
+
+            std::size_t labelColumns() const {
+                return documentProperties.hasRowLabel() ? 1 : 0;
+            }
+
+            // Row of the file holding the rowIndex-th row of the document
+            std::size_t getRowIndex(const std::size_t rowIndex) const {
+                if (rowIndex >= size()) {
+                    throw std::out_of_range("Row index out of range " + std::to_string(rowIndex));
+                }
+
+                std::size_t realRowIndex = rowIndex + headerRows();
+                for (std::size_t removed : removedRows) {
+                    if (removed > realRowIndex) {
+                        break;
+                    }
+                    ++realRowIndex;
+                }
+                return realRowIndex;
+            }
+
+            std::size_t getRowIndex(const std::string &rowName) const {
+                if (!rowNamesBuilt) {
+                    buildRowNames();
+                }
+                auto rowIter = rowNames.find(rowName);
+                if (rowIter == std::end(rowNames)) {
+                    throw std::out_of_range("Row label not found");
+                }
+                return rowIter->second;
+            }
+
+            std::size_t getColumnIndex(const std::size_t columnIndex) const {
+                return columnIndex + labelColumns();
+            }
+
+            std::size_t getColumnIndex(const std::string &columnName) const {
+                auto columnIter = columnNames.find(columnName);
+                if (columnIter == columnNames.end()) {
+                    throw std::out_of_range("column not found: " + columnName);
+                }
+                return columnIter->second;
+            }
+
+            void buildRowNames() const {
+                rowNames.clear();
+                if (!documentProperties.hasRowLabel()) {
+                    throw std::out_of_range("Row label not found");
+                }
+
+                std::string label;
+                for (std::size_t row = 0; row < size(); ++row) {
+                    const std::size_t realRowIndex = getRowIndex(row);
+                    if (find(realRowIndex, 0, label)) {
+                        rowNames.emplace(label, realRowIndex);
+                    }
+                }
+                rowNamesBuilt = true;
+            }
+
+            // Looks the cell up in the edited rows first, then in the parsed rows
+            bool find(std::size_t realRowIndex, std::size_t realColumnIndex, std::string &value) const {
+                auto edited = editedRows.find(realRowIndex);
+                if (edited != editedRows.end()) {
+                    auto finder = edited->second.find(realColumnIndex);
+                    if (finder == edited->second.end()) {
+                        return false;
+                    }
+                    value = finder->second;
+                    return true;
+                }
+
+                if (removedColumns.count(realColumnIndex) > 0) {
+                    return false;
+                }
+                const auto &parsed = documentCache.row(realRowIndex);
+                if (realColumnIndex >= parsed.size()) {
+                    return false;
+                }
+                value = parsed[realColumnIndex];
+                return true;
+            }
+
+            std::string cell(std::size_t realRowIndex, std::size_t realColumnIndex) const {
+                std::string value;
+                if (!find(realRowIndex, realColumnIndex, value)) {
+                    throw std::out_of_range("column out of range : " + std::to_string(realColumnIndex));
+                }
+                return value;
+            }
+
+            std::vector<std::string> row(std::size_t realRowIndex) const {
+                std::vector<std::string> data;
+
+                auto edited = editedRows.find(realRowIndex);
+                if (edited != editedRows.end()) {
+                    std::vector<std::size_t> columns;
+                    for (const auto &entry : edited->second) {
+                        columns.push_back(entry.first);
+                    }
+                    std::sort(columns.begin(), columns.end());
+                    for (std::size_t column : columns) {
+                        data.push_back(edited->second.at(column));
+                    }
+                    return data;
+                }
+
+                const auto &parsed = documentCache.row(realRowIndex);
+                for (std::size_t column = 0; column < parsed.size(); ++column) {
+                    if (removedColumns.count(column) == 0) {
+                        data.push_back(parsed[column]);
+                    }
+                }
+                return data;
+            }
+
+            // A missing cell is skipped, or replaced by fillValue when there is one
+            std::vector<std::string> column(std::size_t realColumnIndex, const std::string *fillValue) const {
+                std::vector<std::string> data;
+                std::string value;
+                for (std::size_t row = 0; row < size(); ++row) {
+                    if (find(getRowIndex(row), realColumnIndex, value)) {
+                        data.push_back(std::move(value));
+                    } else if (fillValue != nullptr) {
+                        data.push_back(*fillValue);
+                    }
+                }
+                return data;
+            }
+
+            // Copies the row out of the cache so that it can be modified
+            MeshRow &editable(std::size_t realRowIndex) {
+                auto edited = editedRows.find(realRowIndex);
+                if (edited != editedRows.end()) {
+                    return edited->second;
+                }
+
+                MeshRow meshRow;
+                const auto &parsed = documentCache.row(realRowIndex);
+                for (std::size_t column = 0; column < parsed.size(); ++column) {
+                    if (removedColumns.count(column) == 0) {
+                        meshRow.emplace(column, parsed[column]);
+                    }
+                }
+                return editedRows[realRowIndex] = std::move(meshRow);
+            }
+
+            std::size_t setColumn(std::size_t realColumnIndex, std::vector<std::string> &&colData) {
+                const std::size_t rows = std::min(colData.size(), size());
+                for (std::size_t row = 0; row < rows; ++row) {
+                    editable(getRowIndex(row))[realColumnIndex] = std::move(colData[row]);
+                }
+                rowNamesBuilt = false;
+                return size();
+            }
+
+            std::size_t removeColumn(std::size_t realColumnIndex) {
+                removedColumns.insert(realColumnIndex);
+                for (auto &row : editedRows) {
+                    row.second.erase(realColumnIndex);
+                }
+                for (auto name = columnNames.begin(); name != columnNames.end();) {
+                    name = name->second == realColumnIndex ? columnNames.erase(name) : std::next(name);
+                }
+                rowNamesBuilt = false;
+                return size();
+            }
+
+            void setRow(std::size_t realRowIndex, std::vector<std::string> &&rowData) {
+                MeshRow meshRow(rowData.size());
+                for (std::size_t index = 0; index < rowData.size(); ++index) {
+                    meshRow.emplace(index, std::move(rowData[index]));
+                }
+                editedRows[realRowIndex] = std::move(meshRow);
+                rowNamesBuilt = false;
+            }
+
+            std::vector<std::string> removeRow(std::size_t realRowIndex) {
+                std::vector<std::string> rowData = row(realRowIndex);
+
+                removedRows.insert(std::upper_bound(removedRows.begin(), removedRows.end(), realRowIndex),
+                                   realRowIndex);
+                editedRows.erase(realRowIndex);
+                rowNamesBuilt = false;
+
+                return rowData;
+            }
+
+            std::string removeCell(std::size_t realRowIndex, std::size_t realColumnIndex) {
+                std::string cellValue = cell(realRowIndex, realColumnIndex);
+                editable(realRowIndex).erase(realColumnIndex);
+                rowNamesBuilt = false;
+                return cellValue;
+            }
+
+        private:
+            mutable read::RowCache documentCache;
+            std::unordered_map<std::size_t, MeshRow> editedRows;
+            // Rows of the file that were removed, sorted
+            std::vector<std::size_t> removedRows;
+            std::set<std::size_t> removedColumns;
+            std::unordered_map<std::string, std::size_t> columnNames;
+            mutable std::unordered_map<std::string, std::size_t> rowNames;
+            mutable bool rowNamesBuilt;
+        };
+    }
+
+    // Opens properties.filePath() as a LazyDocument, only the row index is built up front
+    inline std::unique_ptr<doc::LazyDocument> load_lazy(const Properties &properties) {
+        return std::unique_ptr<doc::LazyDocument>(new doc::LazyDocument(properties));
+    }
+}
+
+#endif //RAPIDCSV_LAZY_DOCUMENT_HPP
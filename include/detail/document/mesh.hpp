@@ -0,0 +1,131 @@
+#ifndef RAPIDCSV_MESH_HPP
+#define RAPIDCSV_MESH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "dense_mesh.hpp"
+#include "column_mesh.hpp"
+#include "properties.hpp"
+#include "detail/reader/field_view.hpp"
+
+namespace rapidcsv {
+    namespace doc {
+
+        // The cells of a document, laid out as picked with PropertiesBuilder::storageMode(): a DenseMesh
+        // for StorageMode::ROWS, a ColumnMesh for StorageMode::COLUMNS. Only one of the two holds cells
+        class Mesh {
+            StorageMode _mode;
+            DenseMesh _rows;
+            ColumnMesh _columns;
+
+        public:
+            explicit Mesh(StorageMode mode = StorageMode::ROWS) : _mode(mode) {}
+
+            StorageMode mode() const {
+                return _mode;
+            }
+
+            void push_back(const std::vector<std::string> &row) {
+                byRows() ? _rows.push_back(row) : _columns.push_back(row);
+            }
+
+            // See DenseMesh::push_back(row, offsets)
+            void push_back(const std::vector<std::string> &row, const std::vector<std::uint64_t> &offsets) {
+                byRows() ? _rows.push_back(row, offsets) : _columns.push_back(row, offsets);
+            }
+
+            void source(const char *bytes, std::size_t size) {
+                byRows() ? _rows.source(bytes, size) : _columns.source(bytes, size);
+            }
+
+            void reserve(std::size_t rows, std::size_t cells, std::size_t bytes) {
+                byRows() ? _rows.reserve(rows, cells, bytes) : _columns.reserve(rows, cells, bytes);
+            }
+
+            std::size_t size() const {
+                return byRows() ? _rows.size() : _columns.size();
+            }
+
+            bool empty() const {
+                return byRows() ? _rows.empty() : _columns.empty();
+            }
+
+            std::size_t columns(std::size_t row) const {
+                return byRows() ? _rows.columns(row) : _columns.columns(row);
+            }
+
+            bool has(std::size_t row, std::size_t column) const {
+                return byRows() ? _rows.has(row, column) : _columns.has(row, column);
+            }
+
+            read::FieldView cell(std::size_t row, std::size_t column) const {
+                return byRows() ? _rows.cell(row, column) : _columns.cell(row, column);
+            }
+
+            std::string str(std::size_t row, std::size_t column) const {
+                return byRows() ? _rows.str(row, column) : _columns.str(row, column);
+            }
+
+            std::vector<std::string> row(std::size_t row) const {
+                return byRows() ? _rows.row(row) : _columns.row(row);
+            }
+
+            std::vector<read::FieldView> column(std::size_t column, std::size_t firstRow = 0) const {
+                return byRows() ? _rows.column(column, firstRow) : _columns.column(column, firstRow);
+            }
+
+            void set(std::size_t row, std::size_t column, const std::string &value) {
+                byRows() ? _rows.set(row, column, value) : _columns.set(row, column, value);
+            }
+
+            void erase(std::size_t row, std::size_t column) {
+                byRows() ? _rows.erase(row, column) : _columns.erase(row, column);
+            }
+
+            void set_column(std::size_t column, const std::vector<std::string> &cells, std::size_t firstRow = 0) {
+                byRows() ? _rows.set_column(column, cells, firstRow) : _columns.set_column(column, cells, firstRow);
+            }
+
+            void erase_column(std::size_t column) {
+                byRows() ? _rows.erase_column(column) : _columns.erase_column(column);
+            }
+
+            void set_row(std::size_t row, const std::vector<std::string> &cells) {
+                byRows() ? _rows.set_row(row, cells) : _columns.set_row(row, cells);
+            }
+
+            void erase_row(std::size_t row) {
+                byRows() ? _rows.erase_row(row) : _columns.erase_row(row);
+            }
+
+            void compact() {
+                byRows() ? _rows.compact() : _columns.compact();
+            }
+
+            std::size_t garbage() const {
+                return byRows() ? _rows.garbage() : _columns.garbage();
+            }
+
+            std::size_t memory() const {
+                return byRows() ? _rows.memory() : _columns.memory();
+            }
+
+            void shrink_to_fit() {
+                byRows() ? _rows.shrink_to_fit() : _columns.shrink_to_fit();
+            }
+
+            void clear() {
+                byRows() ? _rows.clear() : _columns.clear();
+            }
+
+        private:
+            bool byRows() const {
+                return _mode == StorageMode::ROWS;
+            }
+        };
+    }
+}
+
+#endif //RAPIDCSV_MESH_HPP
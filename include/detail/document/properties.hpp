@@ -2,14 +2,23 @@
 #define RAPIDCSV_PROPERTIES_HPP
 
 #include <array>
+#include <cstddef>
 #include <utility>
 #include <string>
+#include <vector>
 #include <functional>
+#include "detail/csv_constants.hpp"
+#include "detail/reader/row_filter.hpp"
 
 namespace rapidcsv {
 
-    enum class RowSepType {
-        CRLF, CR, LF
+    enum class LoadMode {
+        STREAM, MMAP
+    };
+
+    // How a loaded document lays out its cells: row by row, or column by column for whole column scans
+    enum class StorageMode {
+        ROWS, COLUMNS
     };
 
     class Properties {
@@ -46,12 +55,73 @@ namespace rapidcsv {
             return _rowSep;
         }
 
+        // Size of the chunks pulled from the input at a time while parsing
+        std::size_t blockSize() const {
+            return _blockSize;
+        }
+
+        LoadMode loadMode() const {
+            return _loadMode;
+        }
+
+        // With LoadMode::MMAP, the loaded document holds on to the file mapping and its cells refer to the
+        // mapped bytes until edited, rather than to copies. Such a load parses on one thread
+        bool keepMapping() const {
+            return _keepMapping;
+        }
+
+        // Number of threads load() parses with, 0 uses every hardware thread
+        std::size_t parseThreads() const {
+            return _parseThreads;
+        }
+
+        // Bytes of parsed rows a lazily loaded document keeps cached
+        std::size_t cacheLimit() const {
+            return _cacheLimit;
+        }
+
+        // Number of blocks read ahead on a background thread while parsing, 0 reads on the parsing thread
+        std::size_t prefetchBuffers() const {
+            return _prefetchBuffers;
+        }
+
+        // What load() does with malformed rows
+        ErrorPolicy errorPolicy() const {
+            return _errorPolicy;
+        }
+
+        // Columns load() keeps, by index and by header name. When neither is set every column is kept
+        const std::vector<std::size_t> &keptColumns() const {
+            return _keptColumns;
+        }
+
+        const std::vector<std::string> &keptColumnNames() const {
+            return _keptColumnNames;
+        }
+
+        // Rows load() keeps, judged on their fields before conversion
+        const read::RowFilter &rowFilter() const {
+            return _rowFilter;
+        }
+
+        // Data rows load() samples to infer the type of each column, 0 keeps every column as strings
+        std::size_t schemaSample() const {
+            return _schemaSample;
+        }
+
+        StorageMode storageMode() const {
+            return _storageMode;
+        }
+
     private:
 
         explicit Properties(std::string &&pPath, RowSepType rowSep, char quote,
                             char fieldSep, bool hasHeader, bool hasRowLabel) :
                 _filePath(pPath), _quote(quote), _fieldSep(fieldSep),
-                _hasHeader(hasHeader), _hasRowLabel(hasRowLabel), _rowSep(rowSep) {}
+                _hasHeader(hasHeader), _hasRowLabel(hasRowLabel), _rowSep(rowSep), _blockSize(bufLength),
+                _loadMode(LoadMode::STREAM), _keepMapping(false), _parseThreads(1),
+                _cacheLimit(cacheLength), _prefetchBuffers(0), _errorPolicy(ErrorPolicy::THROW), _schemaSample(0),
+                _storageMode(StorageMode::ROWS) {}
 
         std::string _filePath;
         char _quote;
@@ -59,6 +129,18 @@ namespace rapidcsv {
         bool _hasHeader;
         bool _hasRowLabel;
         RowSepType _rowSep;
+        std::size_t _blockSize;
+        LoadMode _loadMode;
+        bool _keepMapping;
+        std::size_t _parseThreads;
+        std::size_t _cacheLimit;
+        std::size_t _prefetchBuffers;
+        ErrorPolicy _errorPolicy;
+        std::vector<std::size_t> _keptColumns;
+        std::vector<std::string> _keptColumnNames;
+        read::RowFilter _rowFilter;
+        std::size_t _schemaSample;
+        StorageMode _storageMode;
     };
 
     class PropertiesBuilder {
@@ -79,62 +161,105 @@ namespace rapidcsv {
         }
 
         PropertiesBuilder &rowSep(RowSepType rowSep) {
-            this->prop = Properties(std::move(prop).filePath(),
-                                          std::move(rowSep),
-                                          std::move(prop).quote(),
-                                          std::move(prop).fieldSep(),
-                                          std::move(prop).hasHeader(),
-                                          std::move(prop).hasRowLabel());
+            prop._rowSep = rowSep;
             return *this;
         }
 
         PropertiesBuilder &quote(char quote) {
-            this->prop = Properties(std::move(prop).filePath(),
-                                          std::move(prop).rowSep(),
-                                          std::move(quote),
-                                          std::move(prop).fieldSep(),
-                                          std::move(prop).hasHeader(),
-                                          std::move(prop).hasRowLabel());
+            prop._quote = quote;
             return *this;
         }
 
         PropertiesBuilder &fieldSep(char fieldSep) {
-            this->prop = Properties(std::move(prop).filePath(),
-                                          std::move(prop).rowSep(),
-                                          std::move(prop).quote(),
-                                          std::move(fieldSep),
-                                          std::move(prop).hasHeader(),
-                                          std::move(prop).hasRowLabel());
+            prop._fieldSep = fieldSep;
             return *this;
         }
 
         PropertiesBuilder &hasHeader() {
-            this->prop = Properties(std::move(prop).filePath(),
-                                          std::move(prop).rowSep(),
-                                          std::move(prop).quote(),
-                                          std::move(prop).fieldSep(),
-                                          true,
-                                          std::move(prop).hasRowLabel());
+            prop._hasHeader = true;
             return *this;
         }
 
         PropertiesBuilder &hasRowLabel() {
-            this->prop = Properties(std::move(prop).filePath(),
-                                          std::move(prop).rowSep(),
-                                          std::move(prop).quote(),
-                                          std::move(prop).fieldSep(),
-                                          std::move(prop).hasHeader(),
-                                          true);
+            prop._hasRowLabel = true;
             return *this;
         }
 
         PropertiesBuilder &filePath(std::string filePath) {
-            this->prop = Properties(std::move(filePath),
-                                          std::move(prop).rowSep(),
-                                          std::move(prop).quote(),
-                                          std::move(prop).fieldSep(),
-                                          std::move(prop).hasHeader(),
-                                          std::move(prop).hasRowLabel());
+            prop._filePath = std::move(filePath);
+            return *this;
+        }
+
+        PropertiesBuilder &blockSize(std::size_t blockSize) {
+            prop._blockSize = blockSize;
+            return *this;
+        }
+
+        PropertiesBuilder &loadMode(LoadMode loadMode) {
+            prop._loadMode = loadMode;
+            return *this;
+        }
+
+        PropertiesBuilder &keepMapping() {
+            prop._keepMapping = true;
+            return *this;
+        }
+
+        PropertiesBuilder &threads(std::size_t threads) {
+            prop._parseThreads = threads;
+            return *this;
+        }
+
+        PropertiesBuilder &cacheLimit(std::size_t bytes) {
+            prop._cacheLimit = bytes;
+            return *this;
+        }
+
+        PropertiesBuilder &prefetch(std::size_t buffers = 3) {
+            prop._prefetchBuffers = buffers;
+            return *this;
+        }
+
+        PropertiesBuilder &errorPolicy(ErrorPolicy policy) {
+            prop._errorPolicy = policy;
+            return *this;
+        }
+
+        PropertiesBuilder &keepColumns(std::vector<std::size_t> columns) {
+            prop._keptColumns = std::move(columns);
+            return *this;
+        }
+
+        PropertiesBuilder &keepColumnNames(std::vector<std::string> names) {
+            prop._keptColumnNames = std::move(names);
+            return *this;
+        }
+
+        // Keeps the rows whose field in `column` passes `predicate`, the rest of the other rows is skipped
+        PropertiesBuilder &filterRows(std::size_t column, read::RowFilter::FieldPredicate predicate) {
+            prop._rowFilter.key(column, std::move(predicate));
+            return *this;
+        }
+
+        PropertiesBuilder &filterRows(std::string column, read::RowFilter::FieldPredicate predicate) {
+            prop._rowFilter.key(std::move(column), std::move(predicate));
+            return *this;
+        }
+
+        // Keeps the rows whose kept fields pass `predicate`
+        PropertiesBuilder &filterRows(read::RowFilter::RowPredicate predicate) {
+            prop._rowFilter.rows(std::move(predicate));
+            return *this;
+        }
+
+        // Infers a type per column from `sampleRows` data rows and holds the numeric columns as numbers
+        PropertiesBuilder &inferSchema(std::size_t sampleRows = 1000) {
+            prop._schemaSample = sampleRows;
+            return *this;
+        }
+
+        PropertiesBuilder &storageMode(StorageMode storageMode) {
+            prop._storageMode = storageMode;
             return *this;
         }
 
@@ -151,7 +276,7 @@ namespace rapidcsv {
     };
 
     namespace operators {
-        const char* to_string(RowSepType rowSepType) {
+        inline const char* to_string(RowSepType rowSepType) {
             switch (rowSepType) {
                 case RowSepType::CRLF:
                     return "\r\n";
@@ -0,0 +1,169 @@
+#ifndef RAPIDCSV_SCHEMA_HPP
+#define RAPIDCSV_SCHEMA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "detail/convert/number_parser.hpp"
+#include "detail/reader/field_view.hpp"
+
+namespace rapidcsv {
+    namespace doc {
+
+        enum class ColumnType {
+            STRING, INT64, DOUBLE, BOOL, DATE
+        };
+
+        // Type and name of every column of a document, in GetColumn() order
+        class Schema {
+            std::vector<std::string> _names;
+            std::vector<ColumnType> _types;
+
+        public:
+            void add(std::string name, ColumnType type) {
+                _names.push_back(std::move(name));
+                _types.push_back(type);
+            }
+
+            std::size_t size() const {
+                return _types.size();
+            }
+
+            bool empty() const {
+                return _types.empty();
+            }
+
+            ColumnType type(std::size_t column) const {
+                check(column);
+                return _types[column];
+            }
+
+            ColumnType type(const std::string &name) const {
+                for (std::size_t column = 0; column < _names.size(); ++column) {
+                    if (_names[column] == name) {
+                        return _types[column];
+                    }
+                }
+                throw std::out_of_range("column not found: " + name);
+            }
+
+            // Header name, empty without a header
+            const std::string &name(std::size_t column) const {
+                check(column);
+                return _names[column];
+            }
+
+            void set(std::size_t column, ColumnType type) {
+                check(column);
+                _types[column] = type;
+            }
+
+            void rename(std::size_t column, std::string name) {
+                check(column);
+                _names[column] = std::move(name);
+            }
+
+        private:
+            void check(std::size_t column) const {
+                if (column >= _types.size()) {
+                    throw std::out_of_range("column out of range : " + std::to_string(column));
+                }
+            }
+        };
+
+        namespace infer {
+            // One bit per ColumnType a cell could hold
+            static constexpr unsigned int64Bit = 1u << 0;
+            static constexpr unsigned doubleBit = 1u << 1;
+            static constexpr unsigned boolBit = 1u << 2;
+            static constexpr unsigned dateBit = 1u << 3;
+            static constexpr unsigned anyBit = int64Bit | doubleBit | boolBit | dateBit;
+
+            // The whole cell parses as a 64 bit integer: 007 and +5 do, 1.0 and " 1" don't
+            inline bool is_integer(const char *first, const char *last) {
+                std::int64_t value;
+                const convert::ParseResult result = convert::parse_integer(first, last, value);
+                return result.ok() && result.end == last;
+            }
+
+            // The whole cell parses as a finite double: 1.50, 1e3 and 9007199254740993 do. inf and nan,
+            // words more often than numbers in a CSV file, don't
+            inline bool is_number(const char *first, const char *last) {
+                const char *digits = first != last && (*first == '-' || *first == '+') ? first + 1 : first;
+                if (digits == last || !(convert::number::is_digit(*digits) || *digits == '.')) {
+                    return false;
+                }
+                double value;
+                const convert::ParseResult result = convert::parse_float(first, last, value);
+                return result.ok() && result.end == last;
+            }
+
+            inline bool is_bool(const char *first, const char *last) {
+                const auto size = last - first;
+                return (size == 4 && convert::number::starts_with(first, last, "true")) ||
+                       (size == 5 && convert::number::starts_with(first, last, "false"));
+            }
+
+            // YYYY-MM-DD, with the month and the day in range
+            inline bool is_date(const char *first, const char *last) {
+                if (last - first != 10 || first[4] != '-' || first[7] != '-') {
+                    return false;
+                }
+                for (int at : {0, 1, 2, 3, 5, 6, 8, 9}) {
+                    if (!convert::number::is_digit(first[at])) {
+                        return false;
+                    }
+                }
+                const int month = (first[5] - '0') * 10 + (first[6] - '0');
+                const int day = (first[8] - '0') * 10 + (first[9] - '0');
+                return month >= 1 && month <= 12 && day >= 1 && day <= 31;
+            }
+
+            inline unsigned cell_types(const read::FieldView &cell) {
+                const char *first = cell.begin(), *last = cell.end();
+                const unsigned asDouble = is_number(first, last) ? doubleBit : 0;
+                if (asDouble && is_integer(first, last)) {
+                    return int64Bit | asDouble;
+                }
+                if (asDouble) {
+                    return doubleBit;
+                }
+                return is_bool(first, last) ? boolBit : is_date(first, last) ? dateBit : 0;
+            }
+        }
+
+        // Narrows down the type of a column one cell at a time. Empty cells fit any type; a column with
+        // only empty cells, or cells of types that don't mix, is a STRING column. INT64 and DOUBLE cells
+        // make a DOUBLE column. A cell is a number when it parses as one in full, however it is written:
+        // TypedColumn keeps the text of those that wouldn't print back the same
+        class TypeInferrer {
+            unsigned _types;
+            bool _seen;
+
+        public:
+            TypeInferrer() : _types(infer::anyBit), _seen(false) {}
+
+            void add(const read::FieldView &cell) {
+                if (!cell.empty()) {
+                    _types &= infer::cell_types(cell);
+                    _seen = true;
+                }
+            }
+
+            ColumnType type() const {
+                if (!_seen) {
+                    return ColumnType::STRING;
+                }
+                return (_types & infer::boolBit) ? ColumnType::BOOL
+                     : (_types & infer::int64Bit) ? ColumnType::INT64
+                     : (_types & infer::doubleBit) ? ColumnType::DOUBLE
+                     : (_types & infer::dateBit) ? ColumnType::DATE
+                     : ColumnType::STRING;
+            }
+        };
+    }
+}
+
+#endif //RAPIDCSV_SCHEMA_HPP
@@ -0,0 +1,178 @@
+#ifndef RAPIDCSV_TYPED_COLUMN_HPP
+#define RAPIDCSV_TYPED_COLUMN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "schema.hpp"
+#include "detail/convert/column_converter.hpp"
+#include "detail/convert/number_formatter.hpp"
+#include "detail/convert/date_time.hpp"
+#include "detail/reader/field_view.hpp"
+
+namespace rapidcsv {
+    namespace doc {
+
+        // A numeric or date column held as numbers instead of strings: 8 bytes a cell, plus a bit for the
+        // empty ones, DATE cells as days since 1970-01-01. Every cell prints back as it was read: the
+        // few cells a number would print differently, like "1.50", "1e3" or "007", keep their text
+        // on the side
+        class TypedColumn {
+            ColumnType _type;
+            std::vector<std::int64_t> _ints;
+            std::vector<double> _doubles;
+            convert::FailureBitmap _empty;
+            // Text of the cells that don't print back as they were read, by row
+            std::unordered_map<std::size_t, std::string> _text;
+
+        public:
+            explicit TypedColumn(ColumnType type = ColumnType::INT64) : _type(type) {}
+
+            // BOOL and STRING columns stay strings
+            static bool is_stored(ColumnType type) {
+                return type == ColumnType::INT64 || type == ColumnType::DOUBLE || type == ColumnType::DATE;
+            }
+
+            // Converts every cell, false when a cell that isn't empty doesn't hold a number of the type
+            bool assign(const std::vector<read::FieldView> &cells) {
+                convert::FailureBitmap failures;
+                if (_type == ColumnType::INT64) {
+                    _ints = convert::convert_column<std::int64_t>(cells, failures);
+                } else if (_type == ColumnType::DATE) {
+                    const std::vector<convert::Date> dates = convert::convert_column<convert::Date>(cells, failures);
+                    _ints.resize(dates.size());
+                    for (std::size_t cell = 0; cell < dates.size(); ++cell) {
+                        _ints[cell] = dates[cell].days;
+                    }
+                } else {
+                    _doubles = convert::convert_column<double>(cells, failures);
+                }
+
+                _empty.reset(cells.size());
+                _text.clear();
+                char buffer[convert::maxNumberLength];
+                for (std::size_t cell = 0; cell < cells.size(); ++cell) {
+                    if (cells[cell].empty()) {
+                        _empty.set(cell);
+                    } else if (failures.test(cell)) {
+                        return false;
+                    } else if (print(cell, buffer) != cells[cell]) {
+                        _text.emplace(cell, cells[cell].str());
+                    }
+                }
+                return true;
+            }
+
+            ColumnType type() const {
+                return _type;
+            }
+
+            std::size_t size() const {
+                return _empty.size();
+            }
+
+            bool empty(std::size_t row) const {
+                return _empty.test(row);
+            }
+
+            // True when T is the type the cells are held as, so values<T>() copies them unchanged. INT64
+            // cells are held by any signed 64 bit integer type, DATE cells by convert::Date
+            template <typename T>
+            bool stored_as() const {
+                switch (_type) {
+                    case ColumnType::INT64:
+                        return std::is_integral<T>::value && std::is_signed<T>::value &&
+                               sizeof(T) == sizeof(std::int64_t);
+                    case ColumnType::DATE:
+                        return std::is_same<T, convert::Date>::value;
+                    default:
+                        return std::is_same<T, double>::value;
+                }
+            }
+
+            // Every cell as a T, empty ones as 0, cast as they are: only exact when stored_as<T>()
+            template <typename T>
+            std::vector<T> values() const {
+                return _type == ColumnType::DOUBLE ? cast<T>(_doubles) : cast<T>(_ints);
+            }
+
+            std::string str(std::size_t row) const {
+                if (_empty.test(row)) {
+                    return "";
+                }
+                const auto text = _text.find(row);
+                char buffer[convert::maxNumberLength];
+                return text != _text.end() ? text->second : print(row, buffer).str();
+            }
+
+            // Number of cells whose text is kept on the side
+            std::size_t texts() const {
+                return _text.size();
+            }
+
+            // False, leaving the cell as it was, when `value` doesn't fit the column
+            bool set(std::size_t row, const std::string &value) {
+                const std::vector<read::FieldView> cell(1, read::FieldView(value));
+                TypedColumn converted(_type);
+                if (!converted.assign(cell)) {
+                    return false;
+                }
+                if (_type == ColumnType::DOUBLE) {
+                    _doubles[row] = converted._doubles[0];
+                } else {
+                    _ints[row] = converted._ints[0];
+                }
+                if (converted._text.empty()) {
+                    _text.erase(row);
+                } else {
+                    _text[row] = value;
+                }
+                if (value.empty()) {
+                    _empty.set(row);
+                } else {
+                    _empty.clear(row);
+                }
+                return true;
+            }
+
+            // Bytes held by the values, the bitmap and the side text, hash nodes roughly counted
+            std::size_t memory() const {
+                std::size_t memory = _ints.capacity() * sizeof(std::int64_t) + _doubles.capacity() * sizeof(double) +
+                                     _empty.words().capacity() * sizeof(std::uint64_t) +
+                                     _text.bucket_count() * sizeof(void *);
+                for (const auto &text : _text) {
+                    memory += sizeof(void *) + sizeof(text) + text.second.capacity();
+                }
+                return memory;
+            }
+
+        private:
+            // Prints the value of a cell into `buffer`, maxNumberLength bytes long
+            read::FieldView print(std::size_t row, char *buffer) const {
+                const char *end = _type == ColumnType::INT64 ? convert::to_chars(buffer, _ints[row])
+                                : _type == ColumnType::DATE ? convert::to_chars(buffer, convert::Date(_ints[row]))
+                                : convert::to_chars(buffer, _doubles[row]);
+                return read::FieldView(buffer, static_cast<std::size_t>(end - buffer));
+            }
+
+            template <typename T, typename U, typename std::enable_if<std::is_same<T, U>::value>::type * = nullptr>
+            static std::vector<T> cast(const std::vector<U> &values) {
+                return values;
+            }
+
+            template <typename T, typename U, typename std::enable_if<!std::is_same<T, U>::value>::type * = nullptr>
+            static std::vector<T> cast(const std::vector<U> &values) {
+                std::vector<T> result(values.size());
+                for (std::size_t cell = 0; cell < values.size(); ++cell) {
+                    result[cell] = static_cast<T>(values[cell]);
+                }
+                return result;
+            }
+        };
+    }
+}
+
+#endif //RAPIDCSV_TYPED_COLUMN_HPP
@@ -1,67 +1,71 @@
 #ifndef RAPIDCSV_ITERATOR_HPP
 #define RAPIDCSV_ITERATOR_HPP
 
-#include "detail/iterator/iterator_base.hpp"
-#include "detail/reader/reader.hpp"
+#include <cstddef>
+#include <iterator>
 #include "detail/csv_except.hpp"
 
 namespace rapidcsv {
-    namespace iter {
+    namespace read {
         template <typename T>
-        class Iterator: public IteratorBase<T> {
-            using rapidcsv::read::Reader;
+        class Reader;
+    }
 
-            explicit Iterator(): _reader(nullptr) {}
+    namespace iter {
+        // Input iterator over what a Reader gives, one next() per increment. The end iterator, and an
+        // iterator whose reader has run out, hold no reader
+        template <typename T>
+        class Iterator {
         protected:
-            Reader<T>* _reader;
+            rapidcsv::read::Reader<T>* _reader;
             T value;
+
         public:
-            explicit Iterator(Reader<T>* reader): _reader(reader) {
-                if (_reader != nullptr && !_reader->has_next()) {
-                    _reader = nullptr;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            Iterator(): _reader(nullptr), value() {}
+
+            explicit Iterator(rapidcsv::read::Reader<T>* reader): _reader(reader), value() {
+                if (_reader != nullptr) {
+                    ++*this;
                 }
             }
 
-            virtual const T operator *() {
+            const T& operator *() const {
                 if (nullptr == _reader) {
                     throw empty_iterator_exception();
-                } else if (!has_init) {
-                    std::advance(*this, 1);
-                    has_init = true;
                 }
                 return value;
             }
 
-            virtual Iterator<T>& operator++ () {
+            const T* operator ->() const {
+                return &**this;
+            }
+
+            Iterator<T>& operator++ () {
                 if (nullptr == _reader) {
                     throw past_the_end_iterator_exception();
                 }
                 if (_reader->has_next()) {
-                    value = std::move(_reader->next());
+                    value = _reader->next();
                 } else {
                     _reader = nullptr;
                 }
                 return *this;
             }
 
-            virtual bool operator != (Iterator<T>& other) noexcept {
-                return _reader != other._reader;
-            }
-
-            ~Iterator<T>() {
-                _reader = nullptr;
+            bool operator == (const Iterator<T>& other) const noexcept {
+                return _reader == other._reader;
             }
 
-            static Iterator<T> &end_iterator() {
-                return iterator_empty;
+            bool operator != (const Iterator<T>& other) const noexcept {
+                return _reader != other._reader;
             }
-
-        private:
-            bool has_init = false;
-            static Iterator<T> iterator_empty;
         };
-
-        template <typename T> Iterator<T> Iterator<T>::iterator_empty;
     }
 }
 
@@ -0,0 +1,111 @@
+#ifndef RAPIDCSV_BLOCK_READER_HPP
+#define RAPIDCSV_BLOCK_READER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <istream>
+#include <streambuf>
+#include "detail/csv_constants.hpp"
+
+namespace rapidcsv {
+    namespace read {
+
+        // Source of contiguous chunks of input. Parsers work on the raw [first, last) range of one
+        // chunk at a time; a chunk stays valid until the next call to next_block.
+        class BlockReader {
+        public:
+            // Points [first, last) at the next non-empty chunk. Returns false once the input is exhausted
+            virtual bool next_block(const char *&first, const char *&last) = 0;
+
+            virtual ~BlockReader() {}
+        };
+
+        // Pulls blockSize bytes at a time straight out of a stream buffer
+        class StreamBlockReader: public BlockReader {
+            std::streambuf *_source;
+            std::vector<char> _buffer;
+
+        public:
+            explicit StreamBlockReader(std::streambuf *source, std::size_t blockSize = bufLength):
+                    _source(source), _buffer(blockSize > 0 ? blockSize : 1) { }
+
+            bool next_block(const char *&first, const char *&last) {
+                if (_source == nullptr) {
+                    return false;
+                }
+
+                const std::streamsize count = _source->sgetn(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+                if (count <= 0) {
+                    _source = nullptr;
+                    return false;
+                }
+
+                first = _buffer.data();
+                last = first + count;
+                return true;
+            }
+        };
+
+        // Input that is already in memory is handed out as a single chunk, without copying
+        class MemoryBlockReader: public BlockReader {
+            const char *_begin, *_end;
+
+        public:
+            explicit MemoryBlockReader(const char *begin, const char *end): _begin(begin), _end(end) { }
+
+            bool next_block(const char *&first, const char *&last) {
+                if (_begin == _end) {
+                    return false;
+                }
+
+                first = _begin;
+                last = _end;
+                _begin = _end;
+                return true;
+            }
+        };
+
+        // Gathers blockSize bytes at a time from an arbitrary input iterator range
+        template <typename InputIt>
+        class IteratorBlockReader: public BlockReader {
+            InputIt _begin, _end;
+            std::vector<char> _buffer;
+
+        public:
+            explicit IteratorBlockReader(InputIt begin, InputIt end, std::size_t blockSize = bufLength):
+                    _begin(std::move(begin)), _end(std::move(end)), _buffer(blockSize > 0 ? blockSize : 1) { }
+
+            bool next_block(const char *&first, const char *&last) {
+                std::size_t count = 0;
+                for (; count < _buffer.size() && _begin != _end; ++_begin) {
+                    _buffer[count++] = *_begin;
+                }
+
+                first = _buffer.data();
+                last = first + count;
+                return count > 0;
+            }
+        };
+
+        inline std::unique_ptr<BlockReader> blockReader(const std::istream &stream, std::size_t blockSize = bufLength) {
+            return std::unique_ptr<BlockReader>(new StreamBlockReader(stream.rdbuf(), blockSize));
+        }
+
+        inline std::unique_ptr<BlockReader> blockReader(const char *begin, const char *end, std::size_t = bufLength) {
+            return std::unique_ptr<BlockReader>(new MemoryBlockReader(begin, end));
+        }
+
+        inline std::unique_ptr<BlockReader> blockReader(char *begin, char *end, std::size_t = bufLength) {
+            return std::unique_ptr<BlockReader>(new MemoryBlockReader(begin, end));
+        }
+
+        template <typename InputIt>
+        std::unique_ptr<BlockReader> blockReader(InputIt begin, InputIt end, std::size_t blockSize = bufLength) {
+            return std::unique_ptr<BlockReader>(new IteratorBlockReader<InputIt>(std::move(begin), std::move(end), blockSize));
+        }
+    }
+}
+
+#endif //RAPIDCSV_BLOCK_READER_HPP
@@ -0,0 +1,80 @@
+#ifndef RAPIDCSV_DIAGNOSTICS_HPP
+#define RAPIDCSV_DIAGNOSTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rapidcsv {
+    namespace read {
+
+        enum class ParseError : std::uint8_t {
+            NONE,
+            // csv_quote_inside_non_quote_field_exception
+            QUOTE_INSIDE_NON_QUOTE_FIELD,
+            // csv_unescaped_quote_exception
+            UNESCAPED_QUOTE,
+            // csv_unterminated_quote_exception
+            UNTERMINATED_QUOTE
+        };
+
+        // Where a malformed row was found. offset is the byte offset of the offending byte in the input,
+        // or of the opening quote for an unterminated field, and line the 1-based line of the input that
+        // byte is on: LF, CR and CR LF each end a line, inside quoted fields too. row is the 1-based row
+        // and column the 1-based field of that row.
+        struct Diagnostic {
+            std::uint64_t offset;
+            std::uint64_t line;
+            std::uint64_t row;
+            std::uint32_t column;
+            ParseError error;
+        };
+
+        // Diagnostics recorded while parsing with ErrorPolicy::COLLECT, one per malformed row
+        class Diagnostics {
+            std::vector<Diagnostic> _records;
+
+        public:
+            using const_iterator = std::vector<Diagnostic>::const_iterator;
+
+            void push_back(const Diagnostic &diagnostic) {
+                _records.push_back(diagnostic);
+            }
+
+            std::size_t size() const {
+                return _records.size();
+            }
+
+            bool empty() const {
+                return _records.empty();
+            }
+
+            const Diagnostic &operator[](std::size_t index) const {
+                return _records[index];
+            }
+
+            const_iterator begin() const {
+                return _records.begin();
+            }
+
+            const_iterator end() const {
+                return _records.end();
+            }
+
+            // Number of records of one kind
+            std::size_t count(ParseError error) const {
+                std::size_t result = 0;
+                for (const auto &record : _records) {
+                    result += record.error == error ? 1 : 0;
+                }
+                return result;
+            }
+
+            void clear() {
+                _records.clear();
+            }
+        };
+    }
+}
+
+#endif //RAPIDCSV_DIAGNOSTICS_HPP
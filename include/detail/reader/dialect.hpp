@@ -0,0 +1,113 @@
+#ifndef RAPIDCSV_DIALECT_HPP
+#define RAPIDCSV_DIALECT_HPP
+
+#include <utility>
+#include "detail/csv_constants.hpp"
+
+namespace rapidcsv {
+    namespace read {
+
+        // A dialect tells the readers which bytes separate fields, quote fields and end rows.
+        //
+        // RowSepType::LF ends rows at LF, a CR right before the LF belongs to the separator and a lone CR
+        // is data. RowSepType::CR is the mirror image. RowSepType::CRLF accepts all three of CR, LF and
+        // CR LF, which is how CSVFieldReader has always split rows.
+
+        // Dialect baked in at compile time, every comparison against it folds into a constant
+        template <char Sep, char Quote, RowSepType RowSep>
+        struct FixedDialect {
+            static constexpr char sep() {
+                return Sep;
+            }
+
+            static constexpr char quote() {
+                return Quote;
+            }
+
+            static constexpr RowSepType rowSep() {
+                return RowSep;
+            }
+
+            // Whether a CR that is not followed by LF ends a row
+            static constexpr bool crEndsRow() {
+                return RowSep != RowSepType::LF;
+            }
+
+            // Whether an LF that does not follow a CR ends a row
+            static constexpr bool lfEndsRow() {
+                return RowSep != RowSepType::CR;
+            }
+        };
+
+        // Any other dialect, known only at run time
+        class RuntimeDialect {
+            char _sep, _quote;
+            RowSepType _rowSep;
+
+        public:
+            explicit RuntimeDialect(char sep = ',', char quote = '"', RowSepType rowSep = RowSepType::CRLF) :
+                    _sep(sep), _quote(quote), _rowSep(rowSep) {}
+
+            char sep() const {
+                return _sep;
+            }
+
+            char quote() const {
+                return _quote;
+            }
+
+            RowSepType rowSep() const {
+                return _rowSep;
+            }
+
+            bool crEndsRow() const {
+                return _rowSep != RowSepType::LF;
+            }
+
+            bool lfEndsRow() const {
+                return _rowSep != RowSepType::CR;
+            }
+        };
+
+        using CSVDialect = FixedDialect<',', '"', RowSepType::CRLF>;
+
+        namespace dialect {
+            template <char Sep, typename Visitor>
+            auto visit_row_sep(RowSepType rowSep, Visitor &&visitor) -> decltype(visitor(CSVDialect())) {
+                switch (rowSep) {
+                    case RowSepType::LF:
+                        return visitor(FixedDialect<Sep, '"', RowSepType::LF>());
+                    case RowSepType::CRLF:
+                        return visitor(FixedDialect<Sep, '"', RowSepType::CRLF>());
+                    default:
+                        return visitor(RuntimeDialect(Sep, '"', rowSep));
+                }
+            }
+        }
+
+        // Calls visitor(dialect) once with the FixedDialect matching the arguments for the common dialects,
+        // comma, tab, semicolon or pipe separated with double quotes and LF or CRLF rows, and with a
+        // RuntimeDialect for anything else
+        template <typename Visitor>
+        auto visit_dialect(char sep, char quote, RowSepType rowSep, Visitor &&visitor)
+                -> decltype(visitor(CSVDialect())) {
+            if (quote == '"') {
+                switch (sep) {
+                    case ',':
+                        return dialect::visit_row_sep<','>(rowSep, std::forward<Visitor>(visitor));
+                    case '\t':
+                        return dialect::visit_row_sep<'\t'>(rowSep, std::forward<Visitor>(visitor));
+                    case ';':
+                        return dialect::visit_row_sep<';'>(rowSep, std::forward<Visitor>(visitor));
+                    case '|':
+                        return dialect::visit_row_sep<'|'>(rowSep, std::forward<Visitor>(visitor));
+                    default:
+                        break;
+                }
+            }
+            return visitor(RuntimeDialect(sep, quote, rowSep));
+        }
+    }
+}
+
+#endif //RAPIDCSV_DIALECT_HPP
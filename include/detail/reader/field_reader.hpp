@@ -1,9 +1,17 @@
 #ifndef RAPIDCSV_FIELD_READER_HPP
 #define RAPIDCSV_FIELD_READER_HPP
 
+#include <cstdint>
 #include <string>
+#include <memory>
 #include <utility>
-#include "simple_reader.hpp"
+#include "reader.hpp"
+#include "block_reader.hpp"
+#include "scanner.hpp"
+#include "dialect.hpp"
+#include "tokenizer.hpp"
+#include "diagnostics.hpp"
+#include "detail/csv_constants.hpp"
 #include "detail/csv_except.hpp"
 
 namespace rapidcsv {
@@ -13,125 +21,326 @@ namespace rapidcsv {
         using except::csv_quote_inside_non_quote_field_exception;
         using except::csv_unterminated_quote_exception;
 
-        template <typename _StreamT>
-        class CSVFieldReader: public SimpleReader<std::string, _StreamT> {
+        // Reads one field per call to next(). A row separator is reported as a field holding a single LF,
+        // for which row_end() is true. Input is consumed one chunk at a time from a BlockReader; runs of
+        // ordinary bytes inside a chunk are skipped with the vectorized DialectScanner, and a field that
+        // spans two chunks simply keeps accumulating into `current` once the next chunk has been pulled in.
+        //
+        // The bytes the scanner stops at go through the token::transitions state machine, indexed by the
+        // CharClassTable of the Dialect, see dialect.hpp and tokenizer.hpp. Readers of a FixedDialect share
+        // one table and scan for constant characters; only a RuntimeDialect builds a table per reader.
+        //
+        // With any ErrorPolicy but THROW, malformed input never throws: the offending quote is kept as
+        // data, error() tells what went wrong in the field last returned, error_offset() and error_line()
+        // where.
+        template <typename Dialect>
+        class DialectFieldReader: public Reader<std::string> {
+            // How the field last returned by next() ended, the separator itself is reported afterwards
+            enum class Ending {
+                NONE, FIELD, ROW, ROW_CR
+            };
+
         protected:
             std::string current;
 
         private:
-            bool _start_quoted_field, _end_quoted_field,
-                    _is_quoted_field, _is_return, _is_next_line, _is_comma;
+            std::unique_ptr<BlockReader> _source;
+            const char *_begin, *_end;
+            // Start of the current chunk and its offset in the input
+            const char *_chunk;
+            std::uint64_t _chunkOffset, _fieldOffset, _errorOffset, _literalQuotes;
+            // Line breaks read so far, and before the start of the current field and the first error
+            std::uint64_t _lines, _fieldLines, _errorLines;
+            // The last byte of the last quoted run was a CR
+            bool _afterCR;
+            token::State _state;
+            Ending _ending;
+            bool _row_end;
+            bool _throws;
+            // The field is tokenized but its bytes are not kept, see skip()
+            bool _discard;
+            ParseError _error;
+            DialectClasses<Dialect> _classes;
+            DialectScanner<Dialect> _scanner;
 
         public:
-            explicit CSVFieldReader(_StreamT &&begin, _StreamT &&end) :
-                    SimpleReader(std::forward(begin), std::forward(end)) {
-                reset();
+            template <typename InputIt>
+            explicit DialectFieldReader(InputIt begin, InputIt end, std::size_t blockSize = bufLength,
+                                        Dialect dialect = Dialect(), ErrorPolicy policy = ErrorPolicy::THROW) :
+                    DialectFieldReader(blockReader(std::move(begin), std::move(end), blockSize), dialect, policy) { }
+
+            explicit DialectFieldReader(std::unique_ptr<BlockReader> source, Dialect dialect = Dialect(),
+                                        ErrorPolicy policy = ErrorPolicy::THROW) :
+                    _source(std::move(source)), _begin(nullptr), _end(nullptr), _chunk(nullptr), _chunkOffset(0),
+                    _fieldOffset(0), _errorOffset(0), _literalQuotes(0), _lines(0), _fieldLines(0), _errorLines(0),
+                    _afterCR(false), _state(token::FIELD_START), _ending(Ending::NONE),
+                    _row_end(false), _throws(policy == ErrorPolicy::THROW), _discard(false), _error(ParseError::NONE),
+                    _classes(dialect), _scanner(dialect) {
+                refill();
             }
 
             std::string next() {
+                if (!read()) {
+                    return std::string() + LF;
+                }
+                return current;
+            }
+
+            // Same as next(), but reads the field into `field`, whose capacity is reused. A row end
+            // leaves `field` as it was
+            void next_into(std::string &field) {
+                // Parse straight into the caller's buffer
+                current.swap(field);
+                try {
+                    read();
+                } catch (...) {
+                    current.swap(field);
+                    throw;
+                }
+                current.swap(field);
+            }
+
+            // Same as next(), but the field is only tokenized: none of its bytes are copied nor unescaped.
+            // row_end() and error() are set as by next()
+            void skip() {
+                _discard = true;
+                try {
+                    read();
+                } catch (...) {
+                    _discard = false;
+                    throw;
+                }
+                _discard = false;
+            }
+
+            bool has_next() const {
+                return _ending != Ending::NONE || !stream_empty();
+            }
+
+            // True when the field last returned by next() marks the end of a row
+            bool row_end() const {
+                return _row_end;
+            }
+
+            // What was malformed in the field last returned by next(), only ever set when not throwing
+            ParseError error() const {
+                return _error;
+            }
+
+            // Byte offset in the input of the first byte of the field last returned by next()
+            std::uint64_t field_offset() const {
+                return _fieldOffset;
+            }
+
+            // Byte offset in the input of the first error of the field last returned by next()
+            std::uint64_t error_offset() const {
+                return _errorOffset;
+            }
+
+            // 1-based line of the input error_offset() is on. LF, CR and CR LF each end a line, inside
+            // quoted fields as well as between rows
+            std::uint64_t error_line() const {
+                return _errorLines + 1;
+            }
+
+            // Number of line breaks read so far
+            std::uint64_t lines() const {
+                return _lines;
+            }
+
+            // Number of quotes read as data inside unquoted fields. Past such a quote, the quote state no
+            // longer follows the parity of the quotes seen, which the parallel parser relies on
+            std::uint64_t literal_quotes() const {
+                return _literalQuotes;
+            }
+
+            // Byte offset in the input of the next byte to be read
+            std::uint64_t position() const {
+                return _chunkOffset + static_cast<std::uint64_t>(_begin - _chunk);
+            }
+
+        private:
+            bool stream_empty() const {
+                return _begin == _end;
+            }
+
+            // Reads the next field into `current`. Returns false, leaving `current` untouched, for a row end
+            bool read() {
                 if (!has_next()) {
                     throw csv_nothing_to_read_exception();
                 }
 
-                if (_is_return) {
-                    if (*_begin == LF) {
-                        _begin++;
+                if (_ending == Ending::ROW_CR) {
+                    if (!stream_empty() && *_begin == LF) {
+                        advance(1);
                     }
-                    _is_next_line = true;
+                    _ending = Ending::ROW;
                 }
 
-                if (_is_next_line) {
-                    reset();
-                    return std::string() + LF;
+                if (_ending == Ending::ROW) {
+                    _ending = Ending::NONE;
+                    _row_end = true;
+                    return false;
                 }
 
-                if (_is_comma && stream_empty()) {
-                    reset();
-                    return "";
+                _row_end = false;
+                _error = ParseError::NONE;
+                _fieldOffset = position();
+                _fieldLines = _lines;
+                const bool afterSep = _ending == Ending::FIELD;
+                _ending = Ending::NONE;
+                _state = token::FIELD_START;
+                current.erase();
+                if (!(afterSep && stream_empty())) {
+                    parseNext();
                 }
-                reset();
-                parseNext();
-                return current;
+                return true;
             }
 
-            bool has_next() const {
-                return _is_next_line || _is_comma || _is_return || !stream_empty();
+            // Moves past n bytes of the current chunk, pulling in the next chunk once this one is used up
+            void advance(std::size_t n) {
+                _begin += n;
+                if (_begin == _end) {
+                    refill();
+                }
             }
 
-        private:
-            bool stream_empty() const {
-                return !SimpleReader::has_next();
+            void refill() {
+                _chunkOffset += static_cast<std::uint64_t>(_end - _chunk);
+                _begin = _end = _chunk = nullptr;
+                while (_source && _source->next_block(_begin, _end) && _begin == _end) { }
+                _chunk = _begin;
+                _scanner.reset();
+            }
+
+            // Throws for the THROW policy, otherwise remembers the first error of the field
+            void fail(ParseError error, std::uint64_t offset) {
+                if (_throws) {
+                    switch (error) {
+                        case ParseError::QUOTE_INSIDE_NON_QUOTE_FIELD:
+                            throw csv_quote_inside_non_quote_field_exception();
+                        case ParseError::UNTERMINATED_QUOTE:
+                            throw csv_unterminated_quote_exception();
+                        default:
+                            throw csv_unescaped_quote_exception();
+                    }
+                }
+                if (_error == ParseError::NONE) {
+                    _error = error;
+                    _errorOffset = offset;
+                    _errorLines = offset == _fieldOffset ? _fieldLines : _lines;
+                }
             }
 
             void parseNext() {
+                if (scan()) {
+                    return;
+                }
+
+                if (_state == token::QUOTED) {
+                    fail(ParseError::UNTERMINATED_QUOTE, _fieldOffset);
+                }
+
+                _ending = Ending::ROW;
+            }
+
+            // Copies the run up to the next structural character in one go, then feeds that character
+            // through consume(). Returns true once the field is terminated
+            bool scan() {
                 while (!stream_empty()) {
-                    char byte = *_begin++;
-                    switch (byte) {
-                        case '"':
-                            if (current.empty()) {
-                                _is_quoted_field = true;
-                                _start_quoted_field = true;
-                                _end_quoted_field = false;
-                            } else if (!_is_quoted_field) {
-                                throw csv_quote_inside_non_quote_field_exception();
-                            } else if (!_end_quoted_field) {
-                                _end_quoted_field = true;
-                            } else {
-                                _end_quoted_field = false;
-                                continue;
-                            }
-                            current += byte;
-                            break;
-
-                        case ',':
-                            if (!_is_quoted_field || _end_quoted_field) {
-                                _is_comma = true;
-                                return;
-                            }
-                            current += byte;
-                            break;
-
-                        case CR:
-                            if (!_is_quoted_field || _end_quoted_field) {
-                                _is_return = true;
-                                return;
-                            }
-                            current += byte;
-                            break;
-
-                        case LF:
-                            if (!_is_quoted_field || _end_quoted_field) {
-                                _is_next_line = true;
-                                return;
-                            }
-                            current += byte;
-                            break;
+                    const char *hit = _state == token::QUOTED ? _scanner.find_quote(_begin, _end)
+                                                              : _scanner.find(_begin, _end);
 
-                        default:
-                            if (!current.empty() && _is_quoted_field && _end_quoted_field) {
-                                throw csv_unescaped_quote_exception();
-                            }
-                            current += byte;
+                    if (hit != _begin) {
+                        // A run of ordinary bytes moves the state machine like a single one
+                        const token::State state = _state;
+                        const token::Transition transition = token::transitions[state][token::DATA];
+                        if (transition.action == token::UNESCAPED_QUOTE) {
+                            fail(ParseError::UNESCAPED_QUOTE, position());
+                            _state = token::UNQUOTED;
+                        } else {
+                            _state = transition.next;
+                        }
+                        if (state == token::QUOTED) {
+                            // Outside quotes the scanner stops at every CR and LF, inside it runs over them
+                            _lines += scan::line_breaks(_begin, hit, _afterCR);
+                        }
+                        if (!_discard) {
+                            current.append(_begin, hit);
+                        }
+                        advance(static_cast<std::size_t>(hit - _begin));
+                        continue;
                     }
-                }
 
-                if (_is_quoted_field && !_end_quoted_field) {
-                    throw csv_unterminated_quote_exception();
+                    const char byte = *_begin;
+                    advance(1);
+                    // The LF of a CR LF never gets here, the CR ending the row skips it
+                    if (byte == CR || byte == LF) {
+                        ++_lines;
+                        _afterCR = false;
+                    }
+                    if (consume(byte, _classes[byte])) {
+                        return true;
+                    }
                 }
+                return false;
+            }
 
-                _is_next_line = true;
+            // Applies the transition for one byte. Returns true once the field is terminated
+            bool consume(char byte, token::Class byteClass) {
+                const token::State state = _state;
+                const token::Transition transition = token::transitions[state][byteClass];
+                _state = transition.next;
+
+                switch (transition.action) {
+                    case token::APPEND:
+                        append(byte);
+                        return false;
+                    case token::SKIP:
+                        return false;
+                    case token::END_FIELD:
+                        _ending = Ending::FIELD;
+                        return true;
+                    case token::END_ROW:
+                        _ending = Ending::ROW;
+                        return true;
+                    case token::END_ROW_CR:
+                        _ending = Ending::ROW_CR;
+                        return true;
+                    case token::PEEK_LF:
+                        if (!stream_empty() && *_begin == LF) {
+                            advance(1);
+                            _ending = Ending::ROW;
+                            return true;
+                        }
+                        // Not part of a CR LF, so the CR is data
+                        _state = state;
+                        return consume(byte, token::DATA);
+                    case token::QUOTE_IN_UNQUOTED:
+                        fail(ParseError::QUOTE_INSIDE_NON_QUOTE_FIELD, position() - 1);
+                        ++_literalQuotes;
+                        append(byte);
+                        return false;
+                    default:
+                        // The rest of the field is read as if it was unquoted
+                        fail(ParseError::UNESCAPED_QUOTE, position() - 1);
+                        _state = token::UNQUOTED;
+                        append(byte);
+                        return false;
+                }
             }
 
-            void reset() {
-                _start_quoted_field = false;
-                _end_quoted_field = true;
-                _is_quoted_field = false;
-                _is_return = false;
-                _is_next_line = false;
-                _is_comma = false;
-                current.erase();
+            void append(char byte) {
+                if (!_discard) {
+                    current += byte;
+                }
             }
         };
+
+        template <char Sep, char Quote, RowSepType RowSep>
+        using BasicFieldReader = DialectFieldReader<FixedDialect<Sep, Quote, RowSep>>;
+
+        using CSVFieldReader = DialectFieldReader<CSVDialect>;
     }
 }
 
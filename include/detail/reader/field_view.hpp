@@ -0,0 +1,47 @@
+#ifndef RAPIDCSV_FIELD_VIEW_HPP
+#define RAPIDCSV_FIELD_VIEW_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace rapidcsv {
+    namespace read {
+
+        // Non-owning pointer + length view of a field's content
+        struct FieldView {
+            const char *data;
+            std::size_t size;
+
+            FieldView(): data(""), size(0) { }
+            FieldView(const char *pData, std::size_t pSize): data(pData), size(pSize) { }
+            explicit FieldView(const std::string &str): data(str.data()), size(str.size()) { }
+
+            const char *begin() const {
+                return data;
+            }
+
+            const char *end() const {
+                return data + size;
+            }
+
+            bool empty() const {
+                return size == 0;
+            }
+
+            std::string str() const {
+                return std::string(data, size);
+            }
+        };
+
+        inline bool operator == (const FieldView &lhs, const FieldView &rhs) {
+            return lhs.size == rhs.size && (lhs.size == 0 || std::memcmp(lhs.data, rhs.data, lhs.size) == 0);
+        }
+
+        inline bool operator != (const FieldView &lhs, const FieldView &rhs) {
+            return !(lhs == rhs);
+        }
+    }
+}
+
+#endif //RAPIDCSV_FIELD_VIEW_HPP
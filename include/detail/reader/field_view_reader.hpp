@@ -0,0 +1,306 @@
+#ifndef RAPIDCSV_FIELD_VIEW_READER_HPP
+#define RAPIDCSV_FIELD_VIEW_READER_HPP
+
+#include <string>
+#include <memory>
+#include <utility>
+#include "reader.hpp"
+#include "block_reader.hpp"
+#include "field_view.hpp"
+#include "scanner.hpp"
+#include "dialect.hpp"
+#include "tokenizer.hpp"
+#include "detail/csv_constants.hpp"
+#include "detail/csv_except.hpp"
+
+namespace rapidcsv {
+    namespace read {
+
+        using except::csv_unescaped_quote_exception;
+        using except::csv_quote_inside_non_quote_field_exception;
+        using except::csv_unterminated_quote_exception;
+
+        // Zero-copy counterpart of DialectFieldReader. next() returns the unescaped content of the next
+        // field: unquoted fields, and quoted fields without doubled quotes, are views straight into
+        // the input chunk. Only a field that needs unescaping, or that spans two chunks, is copied
+        // into a buffer owned by the reader.
+        //
+        // A view stays valid until the following call to next(). Row separators are reported the
+        // same way DialectFieldReader reports them, as an extra entry for which row_end() is true.
+        template <typename Dialect>
+        class DialectFieldViewReader: public Reader<FieldView> {
+            std::unique_ptr<BlockReader> _source;
+            const char *_begin, *_end;
+            std::string _owned;
+            bool _is_return, _is_next_line, _is_comma, _row_end;
+            DialectClasses<Dialect> _classes;
+            DialectScanner<Dialect> _scanner;
+
+        public:
+            template <typename InputIt>
+            explicit DialectFieldViewReader(InputIt begin, InputIt end, std::size_t blockSize = bufLength,
+                                            Dialect dialect = Dialect()) :
+                    DialectFieldViewReader(blockReader(std::move(begin), std::move(end), blockSize), dialect) { }
+
+            explicit DialectFieldViewReader(std::unique_ptr<BlockReader> source, Dialect dialect = Dialect()) :
+                    _source(std::move(source)), _begin(nullptr), _end(nullptr),
+                    _is_return(false), _is_next_line(false), _is_comma(false), _row_end(false),
+                    _classes(dialect), _scanner(dialect) {
+                refill();
+            }
+
+            FieldView next() {
+                if (!has_next()) {
+                    throw csv_nothing_to_read_exception();
+                }
+
+                _row_end = false;
+                if (_is_return) {
+                    _is_return = false;
+                    if (!stream_empty() && *_begin == LF) {
+                        advance(1);
+                    }
+                    _is_next_line = true;
+                }
+
+                if (_is_next_line) {
+                    _is_next_line = _is_comma = false;
+                    _row_end = true;
+                    return FieldView();
+                }
+
+                const bool afterComma = _is_comma;
+                _is_comma = false;
+                if (afterComma && stream_empty()) {
+                    return FieldView();
+                }
+
+                _owned.clear();
+                if (_classes[*_begin] == token::QUOTE) {
+                    advance(1);
+                    return parseQuoted();
+                }
+                return parseUnquoted();
+            }
+
+            bool has_next() const {
+                return _is_next_line || _is_comma || _is_return || !stream_empty();
+            }
+
+            // True when the view last returned by next() marks the end of a row rather than a field
+            bool row_end() const {
+                return _row_end;
+            }
+
+        private:
+            bool stream_empty() const {
+                return _begin == _end;
+            }
+
+            void advance(std::size_t n) {
+                _begin += n;
+                if (_begin == _end) {
+                    refill();
+                }
+            }
+
+            void refill() {
+                _begin = _end = nullptr;
+                while (_source && _source->next_block(_begin, _end) && _begin == _end) { }
+                _scanner.reset();
+            }
+
+            // Marks why the field ended from its terminating byte, false if it is not a terminator
+            bool terminate(char byte) {
+                switch (_classes[byte]) {
+                    case token::SEP:
+                        _is_comma = true;
+                        return true;
+                    case token::CR_END:
+                        _is_return = true;
+                        return true;
+                    case token::ROW_END:
+                        _is_next_line = true;
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+
+            // Called with a CR_BEFORE_LF that was the last byte of its chunk and the next chunk pulled in:
+            // consumes the LF completing the row separator, false if there is none
+            bool take_lf() {
+                if (!stream_empty() && *_begin == LF) {
+                    advance(1);
+                    _is_next_line = true;
+                    return true;
+                }
+                return false;
+            }
+
+            // Ends the field [start, stop), appended to the owned buffer if one is in use, and resumes at
+            // `resume`. A view into the chunk is moved to the owned buffer before the chunk is replaced
+            FieldView close(const char *start, const char *stop, bool owned, const char *resume) {
+                if (owned) {
+                    _owned.append(start, stop);
+                }
+
+                _begin = resume;
+                if (stream_empty()) {
+                    if (!owned) {
+                        _owned.assign(start, stop);
+                        owned = true;
+                    }
+                    refill();
+                }
+
+                return owned ? FieldView(_owned) : FieldView(start, static_cast<std::size_t>(stop - start));
+            }
+
+            FieldView parseUnquoted() {
+                const char *start = _begin, *from = _begin;
+                bool owned = false;
+
+                while (true) {
+                    const char *hit = _scanner.find(from, _end);
+                    if (hit == _end) {
+                        _owned.append(start, hit);
+                        owned = true;
+                        refill();
+                        if (stream_empty()) {
+                            _is_next_line = true;
+                            return FieldView(_owned);
+                        }
+                        start = from = _begin;
+                        continue;
+                    }
+
+                    switch (_classes[*hit]) {
+                        case token::QUOTE:
+                            throw csv_quote_inside_non_quote_field_exception();
+
+                        case token::DATA:
+                            from = hit + 1;
+                            continue;
+
+                        case token::CR_BEFORE_LF:
+                            if (hit + 1 != _end) {
+                                if (hit[1] == LF) {
+                                    _is_next_line = true;
+                                    return close(start, hit, owned, hit + 2);
+                                }
+                                from = hit + 1;
+                                continue;
+                            }
+                            // The CR is the last byte of the chunk, its meaning depends on the next chunk
+                            _owned.append(start, hit);
+                            owned = true;
+                            refill();
+                            if (take_lf()) {
+                                return FieldView(_owned);
+                            }
+                            _owned += CR;
+                            if (stream_empty()) {
+                                _is_next_line = true;
+                                return FieldView(_owned);
+                            }
+                            start = from = _begin;
+                            continue;
+
+                        default:
+                            terminate(*hit);
+                            return close(start, hit, owned, hit + 1);
+                    }
+                }
+            }
+
+            // Called with _begin just past the opening quote
+            FieldView parseQuoted() {
+                const char *start = _begin;
+                bool owned = false;
+
+                while (true) {
+                    if (stream_empty()) {
+                        throw csv_unterminated_quote_exception();
+                    }
+
+                    const char *hit = _scanner.find_quote(_begin, _end);
+                    if (hit == _end) {
+                        _owned.append(start, hit);
+                        owned = true;
+                        refill();
+                        start = _begin;
+                        continue;
+                    }
+
+                    if (hit + 1 == _end) {
+                        // The quote is the last byte of the chunk, its meaning depends on the next chunk
+                        _owned.append(start, hit);
+                        owned = true;
+                        refill();
+                        if (stream_empty()) {
+                            _is_next_line = true;
+                            return FieldView(_owned);
+                        }
+                        if (_classes[*_begin] == token::QUOTE) {
+                            _owned += *_begin;
+                            advance(1);
+                            start = _begin;
+                            continue;
+                        }
+                        return closeQuoted(_begin, _begin, owned, _begin);
+                    }
+
+                    if (_classes[hit[1]] == token::QUOTE) {
+                        // Doubled quote, keep one of them
+                        _owned.append(start, hit + 1);
+                        owned = true;
+                        advance(static_cast<std::size_t>(hit + 2 - _begin));
+                        start = _begin;
+                        continue;
+                    }
+
+                    return closeQuoted(start, hit, owned, hit + 1);
+                }
+            }
+
+            // Ends the quoted field [start, stop) at the byte `after` that follows its closing quote,
+            // which has to separate fields or rows
+            FieldView closeQuoted(const char *start, const char *stop, bool owned, const char *after) {
+                if (terminate(*after)) {
+                    return close(start, stop, owned, after + 1);
+                }
+                if (_classes[*after] != token::CR_BEFORE_LF) {
+                    throw csv_unescaped_quote_exception();
+                }
+
+                if (after + 1 != _end) {
+                    if (after[1] != LF) {
+                        throw csv_unescaped_quote_exception();
+                    }
+                    _is_next_line = true;
+                    return close(start, stop, owned, after + 2);
+                }
+
+                // The CR is the last byte of the chunk
+                if (!owned) {
+                    _owned.assign(start, stop);
+                } else {
+                    _owned.append(start, stop);
+                }
+                refill();
+                if (!take_lf()) {
+                    throw csv_unescaped_quote_exception();
+                }
+                return FieldView(_owned);
+            }
+        };
+
+        template <char Sep, char Quote, RowSepType RowSep>
+        using BasicFieldViewReader = DialectFieldViewReader<FixedDialect<Sep, Quote, RowSep>>;
+
+        using CSVFieldViewReader = DialectFieldViewReader<CSVDialect>;
+    }
+}
+
+#endif //RAPIDCSV_FIELD_VIEW_READER_HPP
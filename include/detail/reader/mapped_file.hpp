@@ -0,0 +1,142 @@
+#ifndef RAPIDCSV_MAPPED_FILE_HPP
+#define RAPIDCSV_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <memory>
+#include "detail/csv_except.hpp"
+
+#if defined(_WIN32)
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace rapidcsv {
+    namespace read {
+
+        // Read-only mapping of a whole file. The parsers read straight from the mapped pages,
+        // and anything holding a shared_ptr to the mapping may keep views into it.
+        class MappedFile {
+            const char *_data;
+            std::size_t _size;
+#if defined(_WIN32)
+            HANDLE _file, _mapping;
+#endif
+
+        public:
+            explicit MappedFile(const std::string &path): _data(nullptr), _size(0) {
+#if defined(_WIN32)
+                _mapping = nullptr;
+                _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                LARGE_INTEGER size;
+                if (_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(_file, &size)) {
+                    close();
+                    throw csv_file_map_exception(path);
+                }
+
+                _size = static_cast<std::size_t>(size.QuadPart);
+                if (_size == 0) {
+                    return;
+                }
+
+                _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                _data = _mapping ? static_cast<const char *>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+                if (_data == nullptr) {
+                    close();
+                    throw csv_file_map_exception(path);
+                }
+#else
+                const int fd = ::open(path.c_str(), O_RDONLY);
+                struct stat info;
+                // A pipe or a device has no size to map
+                if (fd < 0 || ::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+                    if (fd >= 0) {
+                        ::close(fd);
+                    }
+                    throw csv_file_map_exception(path);
+                }
+
+                _size = static_cast<std::size_t>(info.st_size);
+                if (_size > 0) {
+                    void *address = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (address != MAP_FAILED) {
+                        _data = static_cast<const char *>(address);
+                        // Parsing walks the mapping front to back, let the kernel read ahead aggressively
+                        ::madvise(address, _size, MADV_SEQUENTIAL);
+                        ::madvise(address, _size, MADV_WILLNEED);
+                    }
+                }
+                ::close(fd);
+
+                if (_size > 0 && _data == nullptr) {
+                    _size = 0;
+                    throw csv_file_map_exception(path);
+                }
+#endif
+            }
+
+            MappedFile(const MappedFile &) = delete;
+            MappedFile &operator = (const MappedFile &) = delete;
+
+            ~MappedFile() {
+                close();
+            }
+
+            const char *data() const {
+                return _data;
+            }
+
+            std::size_t size() const {
+                return _size;
+            }
+
+            const char *begin() const {
+                return _data;
+            }
+
+            const char *end() const {
+                return _data + _size;
+            }
+
+        private:
+            void close() {
+#if defined(_WIN32)
+                if (_data != nullptr) {
+                    UnmapViewOfFile(_data);
+                }
+                if (_mapping != nullptr) {
+                    CloseHandle(_mapping);
+                }
+                if (_file != INVALID_HANDLE_VALUE) {
+                    CloseHandle(_file);
+                }
+                _mapping = nullptr;
+                _file = INVALID_HANDLE_VALUE;
+#else
+                if (_data != nullptr) {
+                    ::munmap(const_cast<char *>(_data), _size);
+                }
+#endif
+                _data = nullptr;
+                _size = 0;
+            }
+        };
+
+        inline std::shared_ptr<const MappedFile> mapFile(const std::string &path) {
+            return std::make_shared<const MappedFile>(path);
+        }
+    }
+}
+
+#endif //RAPIDCSV_MAPPED_FILE_HPP
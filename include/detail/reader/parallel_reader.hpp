@@ -0,0 +1,310 @@
+#ifndef RAPIDCSV_PARALLEL_READER_HPP
+#define RAPIDCSV_PARALLEL_READER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <vector>
+#include "row_reader.hpp"
+#include "block_reader.hpp"
+#include "scanner.hpp"
+#include "dialect.hpp"
+#include "detail/csv_constants.hpp"
+
+namespace rapidcsv {
+    namespace read {
+        namespace parallel {
+
+            // The rows parsed from one byte range. Diagnostic offsets, lines and rows are relative to the start
+            // of the range until stitched
+            struct RangeResult {
+                std::vector<VS> rows;
+                std::exception_ptr error;
+                std::size_t begin = 0;
+                // Rows read, dropped ones included, and line breaks read
+                std::uint64_t readRows = 0;
+                std::uint64_t lines = 0;
+                bool literalQuotes = false;
+                Diagnostics diagnostics;
+            };
+
+            // Start of the first row in [at, stop), given whether `at` lies inside a quoted field, or `stop`
+            // when no row starts there. Rows end where DialectFieldReader ends them, a CR LF pair ends a row
+            // once, after the LF; `last` is the end of the input
+            template <typename Dialect>
+            const char *row_start(const char *first, const char *at, const char *stop, const char *last,
+                                  bool quoted, const Dialect &dialect) {
+                if (!quoted) {
+                    if (at == first) {
+                        return at;
+                    }
+                    const char previous = at[-1];
+                    if (previous == LF && (dialect.lfEndsRow() || (at - 1 != first && at[-2] == CR))) {
+                        return at;
+                    }
+                    if (previous == CR && dialect.crEndsRow() && (at == last || *at != LF)) {
+                        return at;
+                    }
+                }
+
+                for (; at != stop; ++at) {
+                    const char byte = *at;
+                    if (byte == dialect.quote()) {
+                        quoted = !quoted;
+                    } else if (quoted) {
+                        continue;
+                    } else if (byte == LF && (dialect.lfEndsRow() || (at != first && at[-1] == CR))) {
+                        return at + 1;
+                    } else if (byte == CR && at + 1 != last && at[1] == LF) {
+                        // The LF after `stop` starts its row in the next range
+                        return at + 1 != stop ? at + 2 : stop;
+                    } else if (byte == CR && dialect.crEndsRow()) {
+                        return at + 1;
+                    }
+                }
+                return stop;
+            }
+
+            // Runs work(0) to work(count - 1), each on its own thread but the first
+            template <typename Work>
+            void run(std::size_t count, const Work &work) {
+                std::vector<std::thread> workers;
+                try {
+                    for (std::size_t index = 1; index < count; ++index) {
+                        workers.emplace_back(work, index);
+                    }
+                } catch (...) {
+                    for (auto &worker : workers) {
+                        worker.join();
+                    }
+                    throw;
+                }
+                work(0);
+                for (auto &worker : workers) {
+                    worker.join();
+                }
+            }
+
+            // Only the range at the start of the input holds the header
+            template <typename Dialect>
+            void parse_range(const char *first, const char *last, const Dialect &dialect, ErrorPolicy policy,
+                             const Projection &projection, RowFilter filter, bool atStart, RangeResult &result) {
+                filter.header(filter.header() && atStart);
+                try {
+                    DialectRowReader<Dialect> reader(blockReader(first, last), dialect, policy, &result.diagnostics,
+                                                     projection, std::move(filter));
+                    while (reader.has_next()) {
+                        result.rows.push_back(reader.next());
+                    }
+                    result.readRows = reader.rows();
+                    result.lines = reader.lines();
+                    result.literalQuotes = reader.literal_quotes() != 0;
+                } catch (...) {
+                    result.rows.clear();
+                    result.error = std::current_exception();
+                }
+            }
+
+            template <typename Sink>
+            struct ParallelParse {
+                const char *first, *last;
+                Sink &sink;
+                std::size_t threads, minChunk;
+                ErrorPolicy policy;
+                Diagnostics *diagnostics;
+                const Projection &projection;
+                const RowFilter &filter;
+
+                template <typename Dialect>
+                void operator()(Dialect dialect) const;
+            };
+        }
+
+        // Parses [first, last) on up to `threads` threads (0 uses every hardware thread) and hands the rows
+        // to sink(std::vector<VS> &&) a range at a time, in input order, exactly as a DialectRowReader over
+        // the whole range would produce them.
+        //
+        // The input is cut into byte ranges of at least minChunk bytes and each range owns the rows that
+        // start inside it. Whether a range begins inside a quoted field depends on the number of quotes
+        // before it, so each range first counts its quotes and finds where its first row starts under
+        // both quote states, looking no further than its own end. Chaining the quote parities from the
+        // start of the input then picks the right start of every range, and each range is parsed once,
+        // up to the start of the next one. Each range goes to the sink as soon as it and the ranges before
+        // it are parsed, and its rows are freed once the sink returns. The diagnostics of
+        // ErrorPolicy::COLLECT are stitched together in the same order.
+        //
+        // Column names of the Projection and of the RowFilter key are looked up in the first row before the
+        // input is cut, a RowFilter key by name without a header throws std::invalid_argument.
+        template <typename Sink, typename Dialect = CSVDialect>
+        void parallel_parse_ranges(const char *first, const char *last, Sink &&sink, std::size_t threads = 0,
+                                   std::size_t minChunk = bufLength, Dialect dialect = Dialect(),
+                                   ErrorPolicy policy = ErrorPolicy::THROW, Diagnostics *diagnostics = nullptr,
+                                   Projection projection = Projection(), RowFilter filter = RowFilter()) {
+            using parallel::RangeResult;
+
+            filter.check_header();
+            if (projection.pending() || filter.pending()) {
+                // Errors in the header are left to the parse proper
+                DialectRowReader<Dialect> header(blockReader(first, last), dialect, ErrorPolicy::KEEP_RAW);
+                if (header.has_next()) {
+                    const VS names = header.next();
+                    projection.resolve(names);
+                    filter.resolve(names);
+                }
+            }
+
+            if (threads == 0) {
+                threads = std::thread::hardware_concurrency();
+            }
+
+            const auto size = static_cast<std::size_t>(last - first);
+            std::size_t chunks = size / (minChunk > 0 ? minChunk : 1);
+            chunks = chunks < threads ? chunks : threads;
+
+            if (chunks <= 1) {
+                RangeResult result;
+                parallel::parse_range(first, last, dialect, policy, projection, filter, true, result);
+                if (result.error) {
+                    std::rethrow_exception(result.error);
+                }
+                sink(std::move(result.rows));
+                if (diagnostics) {
+                    for (const auto &diagnostic : result.diagnostics) {
+                        diagnostics->push_back(diagnostic);
+                    }
+                }
+                return;
+            }
+
+            std::vector<const char *> bounds(chunks + 1);
+            for (std::size_t i = 0; i <= chunks; ++i) {
+                bounds[i] = first + size / chunks * i + (size % chunks) * i / chunks;
+            }
+
+            // Written concurrently by the workers, so one byte each rather than a packed std::vector<bool>
+            std::vector<char> oddQuotes(chunks, 0);
+            // First row start of each range outside and inside a quoted field, the range end when none
+            std::vector<std::array<const char *, 2>> starts(chunks);
+            parallel::run(chunks, [&](std::size_t index) {
+                const char *begin = bounds[index];
+                const char *end = bounds[index + 1];
+                oddQuotes[index] = scan::count(begin, end, dialect.quote()) % 2 != 0;
+                starts[index][0] = parallel::row_start(first, begin, end, last, false, dialect);
+                starts[index][1] = index == 0 ? end : parallel::row_start(first, begin, end, last, true, dialect);
+            });
+
+            // Each range runs up to the start of the next one that holds a row start
+            std::vector<const char *> rowBegins;
+            bool quoted = false;
+            for (std::size_t i = 0; i < chunks; ++i) {
+                if (starts[i][quoted ? 1 : 0] != bounds[i + 1]) {
+                    rowBegins.push_back(starts[i][quoted ? 1 : 0]);
+                }
+                quoted = quoted != (oddQuotes[i] != 0);
+            }
+            rowBegins.push_back(last);
+
+            std::vector<RangeResult> results(rowBegins.size() - 1);
+            const auto parse = [&](std::size_t index) {
+                results[index].begin = static_cast<std::size_t>(rowBegins[index] - first);
+                parallel::parse_range(rowBegins[index], rowBegins[index + 1], dialect, policy, projection, filter,
+                                      rowBegins[index] == first, results[index]);
+            };
+            // The first range is parsed on this thread, the others are waited for in order. Leaving early
+            // still waits for every one of them, their futures block until done when destroyed
+            std::vector<std::future<void>> pending;
+            pending.reserve(results.size() - 1);
+            for (std::size_t index = 1; index < results.size(); ++index) {
+                pending.push_back(std::async(std::launch::async, parse, index));
+            }
+            parse(0);
+
+            std::uint64_t readRows = 0, lines = 0;
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                if (i > 0) {
+                    pending[i - 1].wait();
+                }
+                RangeResult *chosen = &results[i];
+                RangeResult rest;
+                if (chosen->literalQuotes && i + 1 < results.size()) {
+                    // A stray quote kept as data puts the quote parity of every later range out of step with
+                    // the parse, so the rest of the input is parsed in one go from this range's first row
+                    rest.begin = chosen->begin;
+                    parallel::parse_range(first + rest.begin, last, dialect, policy, projection, filter,
+                                          rest.begin == 0, rest);
+                    chosen = &rest;
+                }
+                if (chosen->error) {
+                    std::rethrow_exception(chosen->error);
+                }
+                sink(std::move(chosen->rows));
+                chosen->rows = std::vector<VS>();
+                if (diagnostics) {
+                    for (Diagnostic diagnostic : chosen->diagnostics) {
+                        diagnostic.offset += chosen->begin;
+                        diagnostic.line += lines;
+                        diagnostic.row += readRows;
+                        diagnostics->push_back(diagnostic);
+                    }
+                }
+                readRows += chosen->readRows;
+                lines += chosen->lines;
+                if (chosen == &rest) {
+                    break;
+                }
+            }
+        }
+
+        // parallel_parse_ranges() collecting every row
+        template <typename Dialect = CSVDialect>
+        std::vector<VS> parallel_parse(const char *first, const char *last, std::size_t threads = 0,
+                                       std::size_t minChunk = bufLength, Dialect dialect = Dialect(),
+                                       ErrorPolicy policy = ErrorPolicy::THROW, Diagnostics *diagnostics = nullptr,
+                                       Projection projection = Projection(), RowFilter filter = RowFilter()) {
+            std::vector<VS> rows;
+            parallel_parse_ranges(first, last, [&rows](std::vector<VS> &&range) {
+                rows.insert(rows.end(), std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+            }, threads, minChunk, dialect, policy, diagnostics, std::move(projection), std::move(filter));
+            return rows;
+        }
+
+        template <typename Sink>
+        template <typename Dialect>
+        void parallel::ParallelParse<Sink>::operator()(Dialect dialect) const {
+            parallel_parse_ranges(first, last, sink, threads, minChunk, dialect, policy, diagnostics, projection,
+                                  filter);
+        }
+
+        // parallel_parse_ranges specialized at compile time for the common dialects
+        template <typename Sink>
+        void parallel_parse_ranges(const char *first, const char *last, char sep, char quote, RowSepType rowSep,
+                                   Sink &&sink, std::size_t threads = 0, std::size_t minChunk = bufLength,
+                                   ErrorPolicy policy = ErrorPolicy::THROW, Diagnostics *diagnostics = nullptr,
+                                   const Projection &projection = Projection(),
+                                   const RowFilter &filter = RowFilter()) {
+            visit_dialect(sep, quote, rowSep, parallel::ParallelParse<Sink>{first, last, sink, threads, minChunk,
+                                                                            policy, diagnostics, projection, filter});
+        }
+
+        // parallel_parse specialized at compile time for the common dialects
+        inline std::vector<VS> parallel_parse(const char *first, const char *last, char sep, char quote,
+                                              RowSepType rowSep, std::size_t threads = 0,
+                                              std::size_t minChunk = bufLength,
+                                              ErrorPolicy policy = ErrorPolicy::THROW,
+                                              Diagnostics *diagnostics = nullptr,
+                                              const Projection &projection = Projection(),
+                                              const RowFilter &filter = RowFilter()) {
+            std::vector<VS> rows;
+            parallel_parse_ranges(first, last, sep, quote, rowSep, [&rows](std::vector<VS> &&range) {
+                rows.insert(rows.end(), std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+            }, threads, minChunk, policy, diagnostics, projection, filter);
+            return rows;
+        }
+    }
+}
+
+#endif //RAPIDCSV_PARALLEL_READER_HPP
@@ -0,0 +1,138 @@
+#ifndef RAPIDCSV_PREFETCH_READER_HPP
+#define RAPIDCSV_PREFETCH_READER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <vector>
+#include "block_reader.hpp"
+#include "detail/csv_constants.hpp"
+
+namespace rapidcsv {
+    namespace read {
+
+        // StreamBlockReader that reads ahead on a background thread, so that reading the input overlaps
+        // with parsing it. The thread fills a ring of `buffers` blocks of blockSize bytes; next_block()
+        // hands the oldest filled one to the parser and takes back the one handed out before it, so
+        // the reader runs at most buffers - 1 blocks ahead of the parser.
+        //
+        // An exception thrown by the stream buffer is rethrown by next_block() once the blocks read
+        // before it are consumed. Destroying the reader early stops the thread after its current read.
+        class PrefetchBlockReader: public BlockReader {
+            struct Buffer {
+                std::vector<char> data;
+                std::size_t size;
+            };
+
+            std::streambuf *_source;
+            std::vector<Buffer> _ring;
+            std::mutex _mutex;
+            std::condition_variable _changed;
+            // Oldest filled buffer, and the number of filled ones including the one handed out
+            std::size_t _head, _filled;
+            bool _handedOut, _done, _stop;
+            std::exception_ptr _error;
+            std::thread _thread;
+
+        public:
+            explicit PrefetchBlockReader(std::streambuf *source, std::size_t blockSize = bufLength,
+                                         std::size_t buffers = 3) :
+                    _source(source),
+                    _ring(buffers > 1 ? buffers : 2, Buffer{std::vector<char>(blockSize > 0 ? blockSize : 1), 0}),
+                    _head(0), _filled(0), _handedOut(false), _done(false), _stop(false) {
+                _thread = std::thread(&PrefetchBlockReader::produce, this);
+            }
+
+            PrefetchBlockReader(const PrefetchBlockReader &) = delete;
+            PrefetchBlockReader &operator=(const PrefetchBlockReader &) = delete;
+
+            ~PrefetchBlockReader() {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stop = true;
+                }
+                _changed.notify_all();
+                _thread.join();
+            }
+
+            bool next_block(const char *&first, const char *&last) {
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (_handedOut) {
+                    _handedOut = false;
+                    _head = (_head + 1) % _ring.size();
+                    --_filled;
+                    _changed.notify_all();
+                }
+
+                _changed.wait(lock, [this] { return _filled > 0 || _done; });
+                if (_filled == 0) {
+                    if (_error) {
+                        std::exception_ptr error = _error;
+                        _error = nullptr;
+                        std::rethrow_exception(error);
+                    }
+                    return false;
+                }
+
+                const Buffer &buffer = _ring[_head];
+                first = buffer.data.data();
+                last = first + buffer.size;
+                _handedOut = true;
+                return true;
+            }
+
+        private:
+            void produce() {
+                try {
+                    for (std::size_t tail = 0;; tail = (tail + 1) % _ring.size()) {
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            _changed.wait(lock, [this] { return _stop || _filled < _ring.size(); });
+                            if (_stop) {
+                                return;
+                            }
+                        }
+
+                        // The tail buffer is neither filled nor handed out, so it is read into unlocked
+                        Buffer &buffer = _ring[tail];
+                        const std::streamsize count = _source == nullptr ? 0 :
+                                _source->sgetn(buffer.data.data(), static_cast<std::streamsize>(buffer.data.size()));
+                        {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            if (count <= 0) {
+                                _done = true;
+                            } else {
+                                buffer.size = static_cast<std::size_t>(count);
+                                ++_filled;
+                            }
+                        }
+                        _changed.notify_all();
+                        if (count <= 0) {
+                            return;
+                        }
+                    }
+                } catch (...) {
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _error = std::current_exception();
+                        _done = true;
+                    }
+                    _changed.notify_all();
+                }
+            }
+        };
+
+        inline std::unique_ptr<BlockReader> prefetchBlockReader(const std::istream &stream,
+                                                                std::size_t blockSize = bufLength,
+                                                                std::size_t buffers = 3) {
+            return std::unique_ptr<BlockReader>(new PrefetchBlockReader(stream.rdbuf(), blockSize, buffers));
+        }
+    }
+}
+
+#endif //RAPIDCSV_PREFETCH_READER_HPP
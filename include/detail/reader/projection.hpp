@@ -0,0 +1,88 @@
+#ifndef RAPIDCSV_PROJECTION_HPP
+#define RAPIDCSV_PROJECTION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rapidcsv {
+    namespace read {
+
+        // The columns a row reader keeps, by index or by name. Names are looked up in the first row read,
+        // the header. The other columns are still tokenized, but never stored nor unescaped.
+        // A default constructed Projection keeps every column.
+        class Projection {
+            std::vector<std::size_t> _indices;
+            std::vector<std::string> _names;
+            // Indexed by column, resolved once names are known
+            std::vector<char> _keep;
+            bool _resolved;
+
+        public:
+            Projection() : _resolved(true) {}
+
+            explicit Projection(std::vector<std::size_t> indices, std::vector<std::string> names = {}) :
+                    _indices(std::move(indices)), _names(std::move(names)), _resolved(_names.empty()) {
+                for (std::size_t index : _indices) {
+                    mark(index);
+                }
+            }
+
+            // Whether every column is kept
+            bool all() const {
+                return _indices.empty() && _names.empty();
+            }
+
+            // Whether names still have to be looked up in the header
+            bool pending() const {
+                return !_resolved;
+            }
+
+            // Looks the names up in the header, throws std::out_of_range for a name it doesn't hold
+            void resolve(const std::vector<std::string> &header) {
+                for (const auto &name : _names) {
+                    const auto found = std::find(header.begin(), header.end(), name);
+                    if (found == header.end()) {
+                        throw std::out_of_range("column not found: " + name);
+                    }
+                    mark(static_cast<std::size_t>(found - header.begin()));
+                }
+                _resolved = true;
+            }
+
+            bool keep(std::size_t column) const {
+                return all() || (column < _keep.size() && _keep[column] != 0);
+            }
+
+            // Drops the columns that are not kept from a full row
+            void apply(std::vector<std::string> &row) const {
+                if (all()) {
+                    return;
+                }
+                std::size_t count = 0;
+                for (std::size_t column = 0; column < row.size(); ++column) {
+                    if (keep(column)) {
+                        if (count != column) {
+                            row[count].swap(row[column]);
+                        }
+                        ++count;
+                    }
+                }
+                row.resize(count);
+            }
+
+        private:
+            void mark(std::size_t column) {
+                if (column >= _keep.size()) {
+                    _keep.resize(column + 1, 0);
+                }
+                _keep[column] = 1;
+            }
+        };
+    }
+}
+
+#endif //RAPIDCSV_PROJECTION_HPP
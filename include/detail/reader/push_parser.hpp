@@ -0,0 +1,274 @@
+#ifndef RAPIDCSV_PUSH_PARSER_HPP
+#define RAPIDCSV_PUSH_PARSER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include "reader.hpp"
+#include "row_reader.hpp"
+#include "scanner.hpp"
+#include "dialect.hpp"
+#include "tokenizer.hpp"
+#include "diagnostics.hpp"
+#include "detail/csv_constants.hpp"
+#include "detail/csv_except.hpp"
+
+namespace rapidcsv {
+    namespace read {
+
+        // Push counterpart of DialectRowReader, for input that arrives in fragments of any size: pipes,
+        // sockets, message buses. feed() runs the token::transitions state machine over each fragment
+        // and keeps its state when a fragment ends, even in the middle of a field or of a CR LF pair.
+        // Every row that closes is queued and can be taken with next(); finish() closes the last row.
+        //
+        // The rows are exactly those a DialectRowReader over the whole input would produce, with the
+        // same handling of malformed rows for the ErrorPolicy. With ErrorPolicy::THROW, the exception
+        // is thrown out of the feed() or finish() that reaches the malformed byte.
+        template <typename Dialect>
+        class DialectPushParser: public Reader<VS> {
+            DialectClasses<Dialect> _classes;
+            DialectScanner<Dialect> _scanner;
+            ErrorPolicy _policy;
+            Diagnostics *_diagnostics;
+
+            // Fragment being fed
+            const char *_chunk, *_begin, *_end;
+            // Offset of the fragment in the input, and of the current field
+            std::uint64_t _chunkOffset, _fieldOffset;
+            // Rows closed so far, line breaks read so far and before the current field
+            std::uint64_t _rowNumber, _lines, _fieldLines;
+
+            token::State _state;
+            std::string _field;
+            VS _row;
+            Diagnostic _rowError;
+            std::deque<VS> _rows;
+            // Bytes of the current row were consumed, so finish() has a row to close
+            bool _rowStarted;
+            // The fragment ended on a CR that ends the row only if an LF comes next
+            bool _pendingCR;
+            // The last row ended on a CR, an LF right after it belongs to the same separator
+            bool _skipLF;
+            // The last byte of the last quoted run was a CR
+            bool _afterCR;
+
+        public:
+            explicit DialectPushParser(Dialect dialect = Dialect(), ErrorPolicy policy = ErrorPolicy::THROW,
+                                       Diagnostics *diagnostics = nullptr) :
+                    _classes(dialect), _scanner(dialect), _policy(policy),
+                    _diagnostics(diagnostics), _chunk(nullptr), _begin(nullptr), _end(nullptr), _chunkOffset(0),
+                    _fieldOffset(0), _rowNumber(0), _lines(0), _fieldLines(0), _state(token::FIELD_START), _rowError(),
+                    _rowStarted(false), _pendingCR(false), _skipLF(false), _afterCR(false) {}
+
+            // Parses the next fragment of input. The fragment is not referenced once feed() returns
+            void feed(const char *data, std::size_t size) {
+                _chunk = _begin = data;
+                _end = data + size;
+                _scanner.reset();
+
+                if (_begin != _end && _skipLF) {
+                    _skipLF = false;
+                    if (*_begin == LF) {
+                        ++_begin;
+                        ++_fieldOffset;
+                    }
+                }
+                if (_begin != _end && _pendingCR) {
+                    _pendingCR = false;
+                    if (*_begin == LF) {
+                        ++_begin;
+                        end_row();
+                    } else {
+                        consume(CR, token::DATA);
+                    }
+                }
+
+                while (_begin != _end) {
+                    const char *hit = _state == token::QUOTED ? _scanner.find_quote(_begin, _end)
+                                                              : _scanner.find(_begin, _end);
+                    _rowStarted = true;
+
+                    if (hit != _begin) {
+                        // A run of ordinary bytes moves the state machine like a single one
+                        const token::State state = _state;
+                        const token::Transition transition = token::transitions[state][token::DATA];
+                        if (transition.action == token::UNESCAPED_QUOTE) {
+                            fail(ParseError::UNESCAPED_QUOTE, position(), _lines);
+                            _state = token::UNQUOTED;
+                        } else {
+                            _state = transition.next;
+                        }
+                        if (state == token::QUOTED) {
+                            // Outside quotes the scanner stops at every CR and LF, inside it runs over them
+                            _lines += scan::line_breaks(_begin, hit, _afterCR);
+                        }
+                        _field.append(_begin, hit);
+                        _begin = hit;
+                        continue;
+                    }
+
+                    const char byte = *_begin++;
+                    // The LF of a CR LF never gets here, the CR ending the row skips it
+                    if (byte == CR || byte == LF) {
+                        ++_lines;
+                        _afterCR = false;
+                    }
+                    consume(byte, _classes[byte]);
+                }
+
+                _chunkOffset += size;
+                _chunk = _begin = _end = nullptr;
+            }
+
+            void feed(const std::string &data) {
+                feed(data.data(), data.size());
+            }
+
+            // Ends the input, closing the last row if it was not terminated. The parser can then be fed
+            // the next input
+            void finish() {
+                if (_pendingCR) {
+                    _pendingCR = false;
+                    _rowStarted = true;
+                    consume(CR, token::DATA);
+                }
+                if (_state == token::QUOTED) {
+                    fail(ParseError::UNTERMINATED_QUOTE, _fieldOffset, _fieldLines);
+                }
+                if (_rowStarted) {
+                    end_row();
+                }
+                _skipLF = false;
+            }
+
+            bool has_next() const {
+                return !_rows.empty();
+            }
+
+            // Next completed row
+            VS next() {
+                if (_rows.empty()) {
+                    throw csv_nothing_to_read_exception();
+                }
+
+                VS row = std::move(_rows.front());
+                _rows.pop_front();
+                return row;
+            }
+
+            // Number of completed rows waiting to be taken
+            std::size_t pending() const {
+                return _rows.size();
+            }
+
+        private:
+            std::uint64_t position() const {
+                return _chunkOffset + static_cast<std::uint64_t>(_begin - _chunk);
+            }
+
+            void consume(char byte, token::Class byteClass) {
+                const token::State state = _state;
+                const token::Transition transition = token::transitions[state][byteClass];
+                _state = transition.next;
+
+                switch (transition.action) {
+                    case token::APPEND:
+                        _field += byte;
+                        return;
+                    case token::SKIP:
+                        return;
+                    case token::END_FIELD:
+                        end_field();
+                        return;
+                    case token::END_ROW:
+                        end_row();
+                        return;
+                    case token::END_ROW_CR:
+                        end_row();
+                        _skipLF = true;
+                        if (_begin != _end) {
+                            _skipLF = false;
+                            if (*_begin == LF) {
+                                ++_begin;
+                                ++_fieldOffset;
+                            }
+                        }
+                        return;
+                    case token::PEEK_LF:
+                        if (_begin == _end) {
+                            // Decided by the first byte of the next fragment
+                            _state = state;
+                            _pendingCR = true;
+                        } else if (*_begin == LF) {
+                            ++_begin;
+                            end_row();
+                        } else {
+                            // Not part of a CR LF, so the CR is data
+                            _state = state;
+                            consume(byte, token::DATA);
+                        }
+                        return;
+                    case token::QUOTE_IN_UNQUOTED:
+                        fail(ParseError::QUOTE_INSIDE_NON_QUOTE_FIELD, position() - 1, _lines);
+                        _field += byte;
+                        return;
+                    default:
+                        // The rest of the field is read as if it was unquoted
+                        fail(ParseError::UNESCAPED_QUOTE, position() - 1, _lines);
+                        _state = token::UNQUOTED;
+                        _field += byte;
+                        return;
+                }
+            }
+
+            void end_field() {
+                _row.push_back(std::move(_field));
+                _field.clear();
+                _state = token::FIELD_START;
+                _fieldOffset = position();
+                _fieldLines = _lines;
+            }
+
+            void end_row() {
+                end_field();
+                ++_rowNumber;
+                if (_rowError.error == ParseError::NONE || _policy == ErrorPolicy::KEEP_RAW) {
+                    _rows.push_back(std::move(_row));
+                } else if (_policy == ErrorPolicy::COLLECT && _diagnostics) {
+                    _diagnostics->push_back(_rowError);
+                }
+                _row.clear();
+                _rowError = Diagnostic();
+                _rowStarted = false;
+            }
+
+            // Throws for the THROW policy, otherwise remembers the first error of the row. `lines` is the
+            // number of line breaks before `offset`
+            void fail(ParseError error, std::uint64_t offset, std::uint64_t lines) {
+                if (_policy == ErrorPolicy::THROW) {
+                    switch (error) {
+                        case ParseError::QUOTE_INSIDE_NON_QUOTE_FIELD:
+                            throw except::csv_quote_inside_non_quote_field_exception();
+                        case ParseError::UNTERMINATED_QUOTE:
+                            throw except::csv_unterminated_quote_exception();
+                        default:
+                            throw except::csv_unescaped_quote_exception();
+                    }
+                }
+                if (_rowError.error == ParseError::NONE) {
+                    _rowError = Diagnostic{offset, lines + 1, _rowNumber + 1,
+                                           static_cast<std::uint32_t>(_row.size() + 1), error};
+                }
+            }
+        };
+
+        template <char Sep, char Quote, RowSepType RowSep>
+        using BasicPushParser = DialectPushParser<FixedDialect<Sep, Quote, RowSep>>;
+
+        using CSVPushParser = DialectPushParser<CSVDialect>;
+    }
+}
+
+#endif //RAPIDCSV_PUSH_PARSER_HPP
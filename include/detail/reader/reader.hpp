@@ -9,51 +9,23 @@ namespace rapidcsv {
         // Reader interface
         template <typename T>
         class Reader {
+        public:
             using iterator = iter::Iterator<T>;
-            using iter::IteratorBase;
-        protected:
-            Reader(): _end_iterator(iterator::end_iterator()), _iterator(this) {}
-            explicit Reader(Reader<T>&&) = default;
-            explicit Reader<T>& operator =(Reader<T>&&) = default;
 
-        public:
-            virtual bool has_next() const {
-                return begin() != end();
-            }
+            virtual bool has_next() const = 0;
 
             virtual T next() = 0;
 
-            virtual IteratorBase<T>& begin() {
-                return _iterator;
+            // Reads the remaining values in a range for, each one once
+            iterator begin() {
+                return iterator(this);
             }
 
-            virtual const IteratorBase<T>& begin() const {
-                return _iterator;
-            }
-
-            virtual IteratorBase<T>& end() {
-                return _end_iterator;
-            }
-
-            virtual const IteratorBase<T>& end() const {
-                return _end_iterator;
-            }
-
-            virtual ~Reader<T>() {}
-
-//            template <typename Map>
-//            friend Reader<T>& operator | (Reader<T>& reader, Map map);
-//
-//            template <typename F, typename Filter>
-//            friend Reader<F>& operator |> (Reader<T>& reader, Filter filter);
-
-        protected:
-            virtual const T& peek() const {
-                return *begin();
+            iterator end() {
+                return iterator();
             }
 
-        private:
-            iterator &_end_iterator, _iterator;
+            virtual ~Reader() {}
         };
     }
 }
@@ -0,0 +1,125 @@
+#ifndef RAPIDCSV_ROW_CACHE_HPP
+#define RAPIDCSV_ROW_CACHE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "row_index.hpp"
+#include "detail/document/cell_arena.hpp"
+
+namespace rapidcsv {
+    namespace read {
+
+        // Parsed rows of an IndexedFile, blockRows rows at a time. A block is parsed the first time
+        // one of its rows is asked for and stays cached until the cache outgrows its memory limit,
+        // at which point the least recently used blocks are dropped.
+        //
+        // The cells of a block are kept in a doc::ArenaMesh sized after the block's bytes in the file,
+        // so a cached block costs a single slab plus one doc::CellRef per cell, and goes in one free.
+        class RowCache {
+            using Block = doc::ArenaMesh;
+
+            struct Entry {
+                std::size_t id;
+                std::size_t bytes;
+                Block rows;
+            };
+
+            IndexedFile _file;
+            std::size_t _blockRows, _limit, _memory;
+            std::size_t _hits, _misses;
+            // Most recently used block first
+            std::list<Entry> _recent;
+            std::unordered_map<std::size_t, std::list<Entry>::iterator> _blocks;
+
+        public:
+            explicit RowCache(IndexedFile &&file, std::size_t limit, std::size_t blockRows = 1024) :
+                    _file(std::move(file)), _blockRows(blockRows > 0 ? blockRows : 1), _limit(limit), _memory(0),
+                    _hits(0), _misses(0) {}
+
+            std::size_t size() const {
+                return _file.size();
+            }
+
+            const IndexedFile &file() const {
+                return _file;
+            }
+
+            // The parsed row; it stays valid until the next call to row()
+            Block::RowRef row(std::size_t row) {
+                return block(row / _blockRows)[row % _blockRows];
+            }
+
+            // Estimated bytes held by the cached blocks
+            std::size_t memory() const {
+                return _memory;
+            }
+
+            std::size_t blocks() const {
+                return _blocks.size();
+            }
+
+            std::size_t hits() const {
+                return _hits;
+            }
+
+            std::size_t misses() const {
+                return _misses;
+            }
+
+            void clear() {
+                _recent.clear();
+                _blocks.clear();
+                _memory = 0;
+            }
+
+        private:
+            const Block &block(std::size_t id) {
+                auto found = _blocks.find(id);
+                if (found != _blocks.end()) {
+                    ++_hits;
+                    _recent.splice(_recent.begin(), _recent, found->second);
+                    return found->second->rows;
+                }
+
+                ++_misses;
+                const std::size_t first = id * _blockRows;
+                if (first >= size()) {
+                    throw std::out_of_range("Row index out of range " + std::to_string(first));
+                }
+                const std::size_t count = std::min(_blockRows, size() - first);
+
+                const RowIndex &index = _file.index();
+                const auto bytes = static_cast<std::size_t>(index.end_offset(first + count - 1) - index.offset(first));
+                Entry entry{id, 0, Block(bytes)};
+                for (const auto &row : _file.rows(first, count)) {
+                    entry.rows.push_back(row);
+                }
+                entry.rows.shrink_to_fit();
+                entry.bytes = sizeof(Entry) + entry.rows.memory();
+                _memory += entry.bytes;
+                _recent.push_front(std::move(entry));
+                _blocks[id] = _recent.begin();
+                evict();
+                return _recent.front().rows;
+            }
+
+            // Drops least recently used blocks until the limit is met, the newest block always stays
+            void evict() {
+                while (_memory > _limit && _recent.size() > 1) {
+                    _memory -= _recent.back().bytes;
+                    _blocks.erase(_recent.back().id);
+                    _recent.pop_back();
+                }
+            }
+
+        };
+    }
+}
+
+#endif //RAPIDCSV_ROW_CACHE_HPP
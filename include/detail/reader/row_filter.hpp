@@ -0,0 +1,127 @@
+#ifndef RAPIDCSV_ROW_FILTER_HPP
+#define RAPIDCSV_ROW_FILTER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "field_view.hpp"
+
+namespace rapidcsv {
+    namespace read {
+
+        // Decides which rows a row reader keeps, on their fields as read, before any conversion.
+        //
+        // The key predicate looks at a single column, by index or by name in the header, as soon as
+        // that column is read: the rest of a rejected row is skipped without being stored, and a row too
+        // short to hold the key is rejected. The row predicate then sees the kept fields of the rows that
+        // got past the key. A header row, when there is one, is never filtered, and a key by name needs
+        // one: the readers throw std::invalid_argument otherwise. A default constructed
+        // RowFilter keeps every row.
+        class RowFilter {
+        public:
+            using FieldPredicate = std::function<bool(const FieldView &)>;
+            using RowPredicate = std::function<bool(const std::vector<FieldView> &)>;
+
+        private:
+            FieldPredicate _key;
+            std::size_t _keyColumn;
+            std::string _keyName;
+            RowPredicate _row;
+            bool _header;
+            // Views of the row handed to the row predicate, reused from row to row
+            std::vector<FieldView> _views;
+
+        public:
+            RowFilter() : _keyColumn(0), _header(false) {}
+
+            RowFilter &key(std::size_t column, FieldPredicate predicate) {
+                _key = std::move(predicate);
+                _keyColumn = column;
+                _keyName.clear();
+                return *this;
+            }
+
+            RowFilter &key(std::string name, FieldPredicate predicate) {
+                _key = std::move(predicate);
+                _keyName = std::move(name);
+                return *this;
+            }
+
+            RowFilter &rows(RowPredicate predicate) {
+                _row = std::move(predicate);
+                return *this;
+            }
+
+            // Whether the first row read is a header
+            RowFilter &header(bool hasHeader) {
+                _header = hasHeader;
+                return *this;
+            }
+
+            bool header() const {
+                return _header;
+            }
+
+            // Whether every row is kept
+            bool empty() const {
+                return !_key && !_row;
+            }
+
+            // Whether the key name still has to be looked up in the header
+            bool pending() const {
+                return _key && !_keyName.empty();
+            }
+
+            // Throws std::invalid_argument when the key is given by name but no header was announced, as
+            // there is nothing to look it up in
+            void check_header() const {
+                if (pending() && !_header) {
+                    throw std::invalid_argument("row filter key by name without a header: " + _keyName);
+                }
+            }
+
+            // Looks the key name up in the header, throws std::out_of_range if it doesn't hold it
+            void resolve(const std::vector<std::string> &header) {
+                if (!pending()) {
+                    return;
+                }
+                const auto found = std::find(header.begin(), header.end(), _keyName);
+                if (found == header.end()) {
+                    throw std::out_of_range("column not found: " + _keyName);
+                }
+                _keyColumn = static_cast<std::size_t>(found - header.begin());
+                _keyName.clear();
+            }
+
+            // Whether there is a key predicate, once resolved
+            bool keyed() const {
+                return _key && _keyName.empty();
+            }
+
+            bool is_key(std::size_t column) const {
+                return keyed() && column == _keyColumn;
+            }
+
+            bool accept_key(const std::string &field) const {
+                return _key(FieldView(field));
+            }
+
+            bool accept(const std::vector<std::string> &row) {
+                if (!_row) {
+                    return true;
+                }
+                _views.clear();
+                for (const auto &field : row) {
+                    _views.emplace_back(field);
+                }
+                return _row(_views);
+            }
+        };
+    }
+}
+
+#endif //RAPIDCSV_ROW_FILTER_HPP
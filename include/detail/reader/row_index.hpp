@@ -0,0 +1,311 @@
+#ifndef RAPIDCSV_ROW_INDEX_HPP
+#define RAPIDCSV_ROW_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <utility>
+#include "block_reader.hpp"
+#include "row_reader.hpp"
+#include "scanner.hpp"
+#include "dialect.hpp"
+#include "mapped_file.hpp"
+#include "detail/csv_constants.hpp"
+
+namespace rapidcsv {
+    namespace read {
+
+        enum class IndexEncoding {
+            // One uint64 per row, the fastest lookup
+            PLAIN,
+            // Varint deltas between consecutive rows with an absolute checkpoint every deltaStride rows,
+            // typically one or two bytes per row
+            DELTA
+        };
+
+        // Byte offset of the start of every row of an input, so that single rows or row ranges can be
+        // parsed without going through the rows before them. Row i spans [offset(i), end_offset(i)).
+        class RowIndex {
+            static constexpr std::size_t deltaStride = 64;
+
+            IndexEncoding _encoding;
+            std::size_t _rows;
+            std::uint64_t _bytes;
+            std::uint64_t _last;
+            std::vector<std::uint64_t> _offsets;
+            // DELTA: absolute offset and position in _deltas of every deltaStride-th row
+            std::vector<std::pair<std::uint64_t, std::size_t>> _checkpoints;
+            std::vector<std::uint8_t> _deltas;
+
+        public:
+            explicit RowIndex(IndexEncoding encoding = IndexEncoding::PLAIN) :
+                    _encoding(encoding), _rows(0), _bytes(0), _last(0) {}
+
+            IndexEncoding encoding() const {
+                return _encoding;
+            }
+
+            // Number of rows
+            std::size_t size() const {
+                return _rows;
+            }
+
+            bool empty() const {
+                return _rows == 0;
+            }
+
+            // Size of the indexed input
+            std::uint64_t bytes() const {
+                return _bytes;
+            }
+
+            // Memory held by the index itself
+            std::size_t memory() const {
+                return _offsets.capacity() * sizeof(std::uint64_t) +
+                       _checkpoints.capacity() * sizeof(std::pair<std::uint64_t, std::size_t>) +
+                       _deltas.capacity();
+            }
+
+            std::uint64_t offset(std::size_t row) const {
+                if (row >= _rows) {
+                    throw std::out_of_range("Row index out of range " + std::to_string(row));
+                }
+                if (_encoding == IndexEncoding::PLAIN) {
+                    return _offsets[row];
+                }
+
+                const auto &checkpoint = _checkpoints[row / deltaStride];
+                std::uint64_t result = checkpoint.first;
+                std::size_t position = checkpoint.second;
+                for (std::size_t skip = row % deltaStride; skip > 0; --skip) {
+                    result += decode(position);
+                }
+                return result;
+            }
+
+            // Offset just past the end of `row`
+            std::uint64_t end_offset(std::size_t row) const {
+                if (row >= _rows) {
+                    throw std::out_of_range("Row index out of range " + std::to_string(row));
+                }
+                return row + 1 < _rows ? offset(row + 1) : _bytes;
+            }
+
+            // Appends the start of the next row, offsets must be increasing
+            void push_back(std::uint64_t rowOffset) {
+                if (_encoding == IndexEncoding::PLAIN) {
+                    _offsets.push_back(rowOffset);
+                } else if (_rows % deltaStride == 0) {
+                    _checkpoints.emplace_back(rowOffset, _deltas.size());
+                } else {
+                    encode(rowOffset - _last);
+                }
+                _last = rowOffset;
+                ++_rows;
+            }
+
+            // Records the size of the input once all rows are pushed
+            void finish(std::uint64_t totalBytes) {
+                _bytes = totalBytes;
+                _offsets.shrink_to_fit();
+                _checkpoints.shrink_to_fit();
+                _deltas.shrink_to_fit();
+            }
+
+        private:
+            void encode(std::uint64_t value) {
+                while (value >= 0x80) {
+                    _deltas.push_back(static_cast<std::uint8_t>(value | 0x80));
+                    value >>= 7;
+                }
+                _deltas.push_back(static_cast<std::uint8_t>(value));
+            }
+
+            std::uint64_t decode(std::size_t &position) const {
+                std::uint64_t value = 0;
+                for (unsigned shift = 0;; shift += 7) {
+                    const std::uint8_t byte = _deltas[position++];
+                    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0) {
+                        return value;
+                    }
+                }
+            }
+        };
+
+        // Builds a RowIndex one chunk at a time. Row boundaries are found the same way DialectFieldReader
+        // finds them for the dialect: separators outside of quotes end rows, and a CR LF pair ends a row once.
+        class RowIndexer {
+            RowIndex _index;
+            RuntimeDialect _dialect;
+            std::uint64_t _position;
+            bool _quoted, _rowPending, _crPending;
+
+        public:
+            explicit RowIndexer(IndexEncoding encoding = IndexEncoding::PLAIN, RuntimeDialect dialect = RuntimeDialect()) :
+                    _index(encoding), _dialect(dialect), _position(0), _quoted(false), _rowPending(true),
+                    _crPending(false) {}
+
+            void feed(const char *first, const char *last) {
+                if (first == last) {
+                    return;
+                }
+
+                // A CR that ended the previous chunk
+                const bool previousCR = _crPending;
+                _crPending = false;
+                if (previousCR && *first != LF && _dialect.crEndsRow()) {
+                    _rowPending = true;
+                }
+                if (_rowPending) {
+                    _rowPending = false;
+                    _index.push_back(_position);
+                }
+
+                const auto length = static_cast<std::size_t>(last - first);
+                const char quote = _dialect.quote();
+                for (std::size_t base = 0; base < length; base += scan::blockSize) {
+                    // Field separators don't matter here, passing the quote as separator keeps them out of the masks
+                    const StructuralMasks masks = scan::scan(first + base, length - base, quote, quote);
+                    for (std::uint64_t mask = masks.quote | masks.cr | masks.lf; mask != 0; mask &= mask - 1) {
+                        const unsigned bit = scan::trailing_zeros(mask);
+                        const std::uint64_t flag = static_cast<std::uint64_t>(1) << bit;
+                        const std::size_t at = base + bit;
+
+                        if (masks.quote & flag) {
+                            _quoted = !_quoted;
+                        } else if (_quoted) {
+                            continue;
+                        } else if (masks.cr & flag) {
+                            if (at + 1 == length) {
+                                // Whether it ends a row depends on the first byte of the next chunk
+                                _crPending = true;
+                            } else if (_dialect.crEndsRow() && first[at + 1] != LF) {
+                                row_after(at, length);
+                            }
+                        } else if (_dialect.lfEndsRow() || (at > 0 ? first[at - 1] == CR : previousCR)) {
+                            row_after(at, length);
+                        }
+                    }
+                }
+                _position += length;
+            }
+
+            RowIndex finish() {
+                _index.finish(_position);
+                return std::move(_index);
+            }
+
+        private:
+            // The row separator ending at `at` starts a row, unless it is the last byte of the input
+            void row_after(std::size_t at, std::size_t length) {
+                if (at + 1 == length) {
+                    _rowPending = true;
+                } else {
+                    _index.push_back(_position + at + 1);
+                }
+            }
+        };
+
+        inline RowIndex indexRows(BlockReader &source, IndexEncoding encoding = IndexEncoding::PLAIN,
+                                  RuntimeDialect dialect = RuntimeDialect()) {
+            RowIndexer indexer(encoding, dialect);
+            const char *first, *last;
+            while (source.next_block(first, last)) {
+                indexer.feed(first, last);
+            }
+            return indexer.finish();
+        }
+
+        inline RowIndex indexRows(const char *first, const char *last, IndexEncoding encoding = IndexEncoding::PLAIN,
+                                  RuntimeDialect dialect = RuntimeDialect()) {
+            MemoryBlockReader source(first, last);
+            return indexRows(source, encoding, dialect);
+        }
+
+        // Parses all rows of [first, last), which holds `count` rows
+        inline std::vector<VS> readRows(const char *first, const char *last, std::size_t count,
+                                        const RuntimeDialect &dialect = RuntimeDialect()) {
+            std::vector<VS> rows;
+            rows.reserve(count);
+            auto reader = rowReader(blockReader(first, last), dialect.sep(), dialect.quote(), dialect.rowSep());
+            while (reader->has_next()) {
+                rows.push_back(reader->next());
+            }
+            return rows;
+        }
+
+        // Parses `count` rows starting at `row` out of the input [first, last) that `index` describes
+        inline std::vector<VS> readRows(const char *first, const RowIndex &index, std::size_t row, std::size_t count,
+                                        const RuntimeDialect &dialect = RuntimeDialect()) {
+            if (count == 0) {
+                return std::vector<VS>();
+            }
+
+            const auto begin = static_cast<std::size_t>(index.offset(row));
+            const auto end = static_cast<std::size_t>(index.end_offset(row + count - 1));
+            return readRows(first + begin, first + end, count, dialect);
+        }
+
+        // A file plus the index of its rows. Any single row or range of rows is parsed on demand,
+        // straight out of the mapping when the file is mapped, or by seeking in the file otherwise.
+        // Reading from an unmapped file moves its stream position, so such an instance must not be
+        // shared between threads.
+        class IndexedFile {
+            std::shared_ptr<const MappedFile> _mapping;
+            std::unique_ptr<std::ifstream> _file;
+            std::vector<char> _buffer;
+            RowIndex _index;
+            RuntimeDialect _dialect;
+
+        public:
+            explicit IndexedFile(const std::string &path, bool mapped = false,
+                                 IndexEncoding encoding = IndexEncoding::PLAIN, std::size_t blockSize = bufLength,
+                                 RuntimeDialect dialect = RuntimeDialect()) : _dialect(dialect) {
+                if (mapped) {
+                    _mapping = mapFile(path);
+                    _index = indexRows(_mapping->begin(), _mapping->end(), encoding, dialect);
+                } else {
+                    _file.reset(new std::ifstream(path, std::ios::in | std::ios::binary));
+                    StreamBlockReader source(_file->rdbuf(), blockSize);
+                    _index = indexRows(source, encoding, dialect);
+                }
+            }
+
+            const RowIndex &index() const {
+                return _index;
+            }
+
+            std::size_t size() const {
+                return _index.size();
+            }
+
+            VS row(std::size_t row) {
+                auto rows = this->rows(row, 1);
+                return std::move(rows.front());
+            }
+
+            std::vector<VS> rows(std::size_t row, std::size_t count) {
+                if (_mapping || count == 0) {
+                    return readRows(_mapping ? _mapping->begin() : nullptr, _index, row, count, _dialect);
+                }
+
+                const std::uint64_t begin = _index.offset(row);
+                const std::uint64_t end = _index.end_offset(row + count - 1);
+                _buffer.resize(static_cast<std::size_t>(end - begin));
+                _file->clear();
+                _file->seekg(static_cast<std::streamoff>(begin));
+                _file->read(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+
+                return readRows(_buffer.data(), _buffer.data() + _file->gcount(), count, _dialect);
+            }
+        };
+    }
+}
+
+#endif //RAPIDCSV_ROW_INDEX_HPP
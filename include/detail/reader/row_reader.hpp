@@ -1,41 +1,230 @@
 #ifndef RAPIDCSV_ROW_READER_HPP
 #define RAPIDCSV_ROW_READER_HPP
 
+#include <cstdint>
 #include <string>
+#include <vector>
+#include <memory>
 #include <utility>
 #include "field_reader.hpp"
+#include "projection.hpp"
+#include "row_filter.hpp"
 
 namespace rapidcsv {
     namespace read {
 
         using VS = std::vector<std::string>;
 
-        template <class _StreamT>
-        class CSVRowReader: public Reader<VS> {
-            CSVFieldReader<_StreamT> fieldReader;
+        // Reads one row per call to next(). How malformed rows are handled is up to the ErrorPolicy:
+        // SKIP_ROW and COLLECT read one row ahead so that has_next() stays accurate when the last rows
+        // are dropped, and COLLECT records a Diagnostic per dropped row into `diagnostics` when given.
+        //
+        // Rows only hold the columns kept by the Projection, in their input order. The other fields are
+        // skipped by the field reader without being stored, see DialectFieldReader::skip(). Rows rejected
+        // by the RowFilter are dropped like malformed ones, reading one row ahead as well.
+        template <typename Dialect>
+        class DialectRowReader: public Reader<VS> {
+            DialectFieldReader<Dialect> fieldReader;
+            ErrorPolicy _policy;
+            Diagnostics *_diagnostics;
+            Projection _projection;
+            RowFilter _filter;
+            // Rows read so far, including the dropped ones and the one read ahead
+            std::uint64_t _row;
+            VS _ahead;
+            bool _hasAhead;
+            // Input offsets of the fields of the row last returned and of the one read ahead
+            std::vector<std::uint64_t> _offsets, _aheadOffsets;
+            // Field read past the end of a row's container, not yet known to be a field
+            std::string _spare;
 
         public:
+            template <typename InputIt>
+            explicit DialectRowReader(InputIt begin, InputIt end, std::size_t blockSize = bufLength,
+                                      Dialect dialect = Dialect(), ErrorPolicy policy = ErrorPolicy::THROW,
+                                      Diagnostics *diagnostics = nullptr, Projection projection = Projection(),
+                                      RowFilter filter = RowFilter()):
+                    DialectRowReader(blockReader(std::move(begin), std::move(end), blockSize), dialect, policy,
+                                     diagnostics, std::move(projection), std::move(filter)) {
+            }
 
-            explicit CSVRowReader(_StreamT &&begin, _StreamT &&end):
-                    fieldReader(std::forward<_StreamT>(begin), std::forward<_StreamT>(end)) {
+            explicit DialectRowReader(std::unique_ptr<BlockReader> source, Dialect dialect = Dialect(),
+                                      ErrorPolicy policy = ErrorPolicy::THROW, Diagnostics *diagnostics = nullptr,
+                                      Projection projection = Projection(), RowFilter filter = RowFilter()):
+                    fieldReader(std::move(source), dialect, policy), _policy(policy), _diagnostics(diagnostics),
+                    _projection(std::move(projection)), _filter(std::move(filter)), _row(0), _hasAhead(false) {
+                _filter.check_header();
+                if (skips()) {
+                    fetch();
+                }
             }
 
             bool has_next() const {
-                return fieldReader.has_next();
+                return skips() ? _hasAhead : fieldReader.has_next();
             };
 
             auto next() -> VS {
-                std::string rowSep(1, LF);
                 VS row;
-                for (std::string field; fieldReader.has_next(); row.emplace_back(field)) {
-                    field = std::move(fieldReader.next());
-                    if (field == rowSep) {
+                next_into(row);
+                return row;
+            }
+
+            // Same as next(), but reads the row into `row`, reusing the vector and its strings. Once the
+            // row lengths and field sizes are stable, reading a row performs no allocation
+            void next_into(VS &row) {
+                if (!skips()) {
+                    Diagnostic unused;
+                    read(row, _offsets, unused);
+                    return;
+                }
+                if (!_hasAhead) {
+                    throw csv_nothing_to_read_exception();
+                }
+
+                // The row just read ahead goes out, the caller's containers are recycled for the next
+                row.swap(_ahead);
+                _offsets.swap(_aheadOffsets);
+                fetch();
+            }
+
+            // Rows read from the input so far, dropped ones included
+            std::uint64_t rows() const {
+                return _row;
+            }
+
+            // Line breaks read from the input so far, see DialectFieldReader::error_line()
+            std::uint64_t lines() const {
+                return fieldReader.lines();
+            }
+
+            // Byte offset in the input of each field of the row last returned, as DialectFieldReader::field_offset().
+            // Empty for a header whose columns the Projection reordered
+            const std::vector<std::uint64_t> &offsets() const {
+                return _offsets;
+            }
+
+            // See DialectFieldReader::literal_quotes()
+            std::uint64_t literal_quotes() const {
+                return fieldReader.literal_quotes();
+            }
+
+        private:
+            // Whether rows can be dropped
+            bool skips() const {
+                return _policy == ErrorPolicy::SKIP_ROW || _policy == ErrorPolicy::COLLECT || !_filter.empty();
+            }
+
+            // Reads the next row into `row` and where its fields start into `offsets`, `diagnostic`
+            // describes its first error if any. Returns false when the filter rejects the row
+            bool read(VS &row, std::vector<std::uint64_t> &offsets, Diagnostic &diagnostic) {
+                diagnostic = Diagnostic();
+                offsets.clear();
+                ++_row;
+                // Column names are looked up in the header, so that one is read whole and never filtered
+                const bool header = _row == 1 && (_projection.pending() || _filter.header());
+                bool rejected = false;
+                bool keySeen = header || !_filter.keyed();
+                std::size_t count = 0;
+                for (std::size_t column = 0; fieldReader.has_next(); ++column) {
+                    const bool key = !header && _filter.is_key(column);
+                    const bool kept = header || _projection.keep(column);
+                    if (rejected || (!kept && !key)) {
+                        fieldReader.skip();
+                        if (fieldReader.row_end()) {
+                            break;
+                        }
+                        note(diagnostic, column);
+                        continue;
+                    }
+
+                    std::string &field = kept && count < row.size() ? row[count] : _spare;
+                    fieldReader.next_into(field);
+                    if (fieldReader.row_end()) {
                         break;
                     }
+                    note(diagnostic, column);
+                    if (key) {
+                        keySeen = true;
+                        rejected = !_filter.accept_key(field);
+                    }
+                    if (kept) {
+                        offsets.push_back(fieldReader.field_offset());
+                        if (count == row.size()) {
+                            row.push_back(std::move(_spare));
+                            _spare.clear();
+                        }
+                        ++count;
+                    }
+                }
+                row.resize(count);
+
+                if (header) {
+                    _projection.resolve(row);
+                    _filter.resolve(row);
+                    _projection.apply(row);
+                    offsets.clear();
+                    return true;
+                }
+                return keySeen && !rejected && _filter.accept(row);
+            }
+
+            // Keeps the first error of the row
+            void note(Diagnostic &diagnostic, std::size_t column) const {
+                if (fieldReader.error() != ParseError::NONE && diagnostic.error == ParseError::NONE) {
+                    diagnostic = Diagnostic{fieldReader.error_offset(), fieldReader.error_line(), _row,
+                                            static_cast<std::uint32_t>(column + 1), fieldReader.error()};
+                }
+            }
+
+            // Reads ahead up to the next row that is kept
+            void fetch() {
+                _hasAhead = false;
+                while (fieldReader.has_next()) {
+                    Diagnostic diagnostic;
+                    const bool accepted = read(_ahead, _aheadOffsets, diagnostic);
+                    if (diagnostic.error != ParseError::NONE && _policy != ErrorPolicy::KEEP_RAW) {
+                        if (_policy == ErrorPolicy::COLLECT && _diagnostics) {
+                            _diagnostics->push_back(diagnostic);
+                        }
+                    } else if (accepted) {
+                        _hasAhead = true;
+                        return;
+                    }
                 }
-                return row;
             }
         };
+
+        template <char Sep, char Quote, RowSepType RowSep>
+        using BasicRowReader = DialectRowReader<FixedDialect<Sep, Quote, RowSep>>;
+
+        using CSVRowReader = DialectRowReader<CSVDialect>;
+
+        namespace dialect {
+            struct MakeRowReader {
+                std::unique_ptr<BlockReader> &source;
+                ErrorPolicy policy;
+                Diagnostics *diagnostics;
+                const Projection &projection;
+                const RowFilter &filter;
+
+                template <typename Dialect>
+                std::unique_ptr<Reader<VS>> operator()(Dialect dialect) const {
+                    return std::unique_ptr<Reader<VS>>(new DialectRowReader<Dialect>(std::move(source), dialect, policy,
+                                                                                     diagnostics, projection, filter));
+                }
+            };
+        }
+
+        // Row reader for the given dialect, specialized at compile time for the common ones
+        inline std::unique_ptr<Reader<VS>> rowReader(std::unique_ptr<BlockReader> source, char sep = ',',
+                                                     char quote = '"', RowSepType rowSep = RowSepType::CRLF,
+                                                     ErrorPolicy policy = ErrorPolicy::THROW,
+                                                     Diagnostics *diagnostics = nullptr,
+                                                     const Projection &projection = Projection(),
+                                                     const RowFilter &filter = RowFilter()) {
+            return visit_dialect(sep, quote, rowSep,
+                                 dialect::MakeRowReader{source, policy, diagnostics, projection, filter});
+        }
     }
 }
 
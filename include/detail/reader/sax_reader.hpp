@@ -0,0 +1,81 @@
+#ifndef RAPIDCSV_SAX_READER_HPP
+#define RAPIDCSV_SAX_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include "field_view_reader.hpp"
+#include "block_reader.hpp"
+#include "dialect.hpp"
+#include "detail/csv_constants.hpp"
+
+namespace rapidcsv {
+    namespace read {
+
+        // Event driven reader: every field goes straight to handler.on_field(FieldView, column) and every
+        // row end to handler.on_row_end(row), columns and rows counted from 0. Nothing is gathered into
+        // rows, so a handler that aggregates as it goes parses the input without any per-row allocation.
+        //
+        // Fields are unescaped as by DialectFieldViewReader, and a view is only valid during the call
+        // it is passed to. The Handler is a template parameter so that its calls inline into the loop.
+        template <typename Handler, typename Dialect = CSVDialect>
+        class SaxReader {
+            DialectFieldViewReader<Dialect> _fields;
+            Handler &_handler;
+
+        public:
+            template <typename InputIt>
+            SaxReader(InputIt begin, InputIt end, Handler &handler, std::size_t blockSize = bufLength,
+                      Dialect dialect = Dialect()) :
+                    _fields(std::move(begin), std::move(end), blockSize, dialect), _handler(handler) {}
+
+            SaxReader(std::unique_ptr<BlockReader> source, Handler &handler, Dialect dialect = Dialect()) :
+                    _fields(std::move(source), dialect), _handler(handler) {}
+
+            // Streams the whole input through the handler, returns the number of rows
+            std::uint64_t run() {
+                std::uint64_t row = 0;
+                std::size_t column = 0;
+                while (_fields.has_next()) {
+                    const FieldView field = _fields.next();
+                    if (_fields.row_end()) {
+                        _handler.on_row_end(row++);
+                        column = 0;
+                    } else {
+                        _handler.on_field(field, column++);
+                    }
+                }
+
+                // A last row that ended on a separator rather than a row separator
+                if (column != 0) {
+                    _handler.on_row_end(row++);
+                }
+                return row;
+            }
+        };
+
+        namespace dialect {
+            template <typename Handler>
+            struct SaxParse {
+                std::unique_ptr<BlockReader> &source;
+                Handler &handler;
+
+                template <typename Dialect>
+                std::uint64_t operator()(Dialect dialect) const {
+                    return SaxReader<Handler, Dialect>(std::move(source), handler, dialect).run();
+                }
+            };
+        }
+
+        // Streams `source` through `handler`, see SaxReader. Specialized at compile time for the common
+        // dialects. Returns the number of rows
+        template <typename Handler>
+        std::uint64_t sax_parse(std::unique_ptr<BlockReader> source, Handler &handler, char sep = ',',
+                                char quote = '"', RowSepType rowSep = RowSepType::CRLF) {
+            return visit_dialect(sep, quote, rowSep, dialect::SaxParse<Handler>{source, handler});
+        }
+    }
+}
+
+#endif //RAPIDCSV_SAX_READER_HPP
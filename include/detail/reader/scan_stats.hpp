@@ -0,0 +1,171 @@
+#ifndef RAPIDCSV_SCAN_STATS_HPP
+#define RAPIDCSV_SCAN_STATS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "block_reader.hpp"
+#include "scanner.hpp"
+#include "dialect.hpp"
+#include "detail/csv_constants.hpp"
+
+namespace rapidcsv {
+    namespace read {
+
+        // Shape of an input, as a row reader would parse it
+        struct ScanStats {
+            std::uint64_t bytes = 0;
+            std::uint64_t rows = 0;
+            std::uint64_t fields = 0;
+            // Fields that open with a quote
+            std::uint64_t quotedFields = 0;
+            // Number of rows with i fields at index i
+            std::vector<std::uint64_t> fieldCounts;
+
+            // Most fields in a row
+            std::size_t maxFields() const {
+                return fieldCounts.empty() ? 0 : fieldCounts.size() - 1;
+            }
+
+            // Share of the fields that are quoted
+            double quotedDensity() const {
+                return fields == 0 ? 0.0 : static_cast<double>(quotedFields) / static_cast<double>(fields);
+            }
+        };
+
+        // Gathers ScanStats one chunk at a time without storing a single field. Only the structural
+        // bytes found by the vectorized scanner are looked at, and rows end exactly where RowIndexer
+        // ends them. Quotes are followed by parity, so the figures are exact for well-formed input.
+        template <typename Dialect>
+        class DialectStatsScanner {
+            ScanStats _stats;
+            Dialect _dialect;
+            std::uint64_t _position;
+            // Where the current field and row start
+            std::uint64_t _fieldStart, _rowStart;
+            // Separators seen in the current row
+            std::size_t _separators;
+            bool _quoted, _crPending;
+
+        public:
+            explicit DialectStatsScanner(Dialect dialect = Dialect()) :
+                    _dialect(dialect), _position(0), _fieldStart(0), _rowStart(0), _separators(0), _quoted(false),
+                    _crPending(false) {}
+
+            void feed(const char *first, const char *last) {
+                if (first == last) {
+                    return;
+                }
+
+                // A CR that ended the previous chunk
+                const bool previousCR = _crPending;
+                _crPending = false;
+                if (previousCR && *first != LF && _dialect.crEndsRow()) {
+                    end_row(_position);
+                }
+
+                const auto length = static_cast<std::size_t>(last - first);
+                const char sep = _dialect.sep();
+                const char quote = _dialect.quote();
+                for (std::size_t base = 0; base < length; base += scan::blockSize) {
+                    const StructuralMasks masks = scan::scan(first + base, length - base, sep, quote);
+                    for (std::uint64_t mask = masks.any(); mask != 0; mask &= mask - 1) {
+                        const unsigned bit = scan::trailing_zeros(mask);
+                        const std::uint64_t flag = static_cast<std::uint64_t>(1) << bit;
+                        const std::size_t at = base + bit;
+                        const std::uint64_t position = _position + at;
+
+                        if (masks.quote & flag) {
+                            if (!_quoted && position == _fieldStart) {
+                                ++_stats.quotedFields;
+                            }
+                            _quoted = !_quoted;
+                        } else if (_quoted) {
+                            continue;
+                        } else if (masks.sep & flag) {
+                            ++_separators;
+                            _fieldStart = position + 1;
+                        } else if (masks.cr & flag) {
+                            if (at + 1 == length) {
+                                // Whether it ends a row depends on the first byte of the next chunk
+                                _crPending = true;
+                            } else if (_dialect.crEndsRow() && first[at + 1] != LF) {
+                                end_row(position + 1);
+                            }
+                        } else if (_dialect.lfEndsRow() || (at > 0 ? first[at - 1] == CR : previousCR)) {
+                            end_row(position + 1);
+                        }
+                    }
+                }
+                _position += length;
+            }
+
+            ScanStats finish() {
+                if (_crPending && _dialect.crEndsRow()) {
+                    end_row(_position);
+                }
+                _crPending = false;
+                // A last row without a row separator
+                if (_rowStart < _position) {
+                    end_row(_position);
+                }
+                _stats.bytes = _position;
+                return _stats;
+            }
+
+        private:
+            void end_row(std::uint64_t next) {
+                const std::size_t fields = _separators + 1;
+                if (fields >= _stats.fieldCounts.size()) {
+                    _stats.fieldCounts.resize(fields + 1, 0);
+                }
+                ++_stats.fieldCounts[fields];
+                ++_stats.rows;
+                _stats.fields += fields;
+                _separators = 0;
+                _fieldStart = _rowStart = next;
+            }
+        };
+
+        using StatsScanner = DialectStatsScanner<RuntimeDialect>;
+
+        template <typename Dialect = CSVDialect>
+        ScanStats scanStats(BlockReader &source, Dialect dialect = Dialect()) {
+            DialectStatsScanner<Dialect> scanner(dialect);
+            const char *first, *last;
+            while (source.next_block(first, last)) {
+                scanner.feed(first, last);
+            }
+            return scanner.finish();
+        }
+
+        template <typename Dialect = CSVDialect>
+        ScanStats scanStats(const char *first, const char *last, Dialect dialect = Dialect()) {
+            MemoryBlockReader source(first, last);
+            return scanStats(source, dialect);
+        }
+
+        namespace dialect {
+            struct ScanStatsOf {
+                BlockReader &source;
+
+                template <typename Dialect>
+                ScanStats operator()(Dialect dialect) const {
+                    return scanStats(source, dialect);
+                }
+            };
+        }
+
+        // scanStats() specialized at compile time for the common dialects
+        inline ScanStats scanStats(BlockReader &source, char sep, char quote, RowSepType rowSep) {
+            return visit_dialect(sep, quote, rowSep, dialect::ScanStatsOf{source});
+        }
+
+        inline ScanStats scanStats(const char *first, const char *last, char sep, char quote, RowSepType rowSep) {
+            MemoryBlockReader source(first, last);
+            return scanStats(source, sep, quote, rowSep);
+        }
+    }
+}
+
+#endif //RAPIDCSV_SCAN_STATS_HPP
@@ -0,0 +1,298 @@
+#ifndef RAPIDCSV_SCANNER_HPP
+#define RAPIDCSV_SCANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "dialect.hpp"
+
+// Vectorized scanning is picked at compile time: AVX2 when the compiler targets it,
+// SSE2 as the x86 baseline, and a portable scalar loop everywhere else.
+// Define RAPIDCSV_NO_SIMD to force the scalar path.
+#if !defined(RAPIDCSV_NO_SIMD)
+#   if defined(__AVX2__)
+#       define RAPIDCSV_SCAN_AVX2
+#   elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#       define RAPIDCSV_SCAN_SSE2
+#   elif defined(_M_IX86_FP)
+#       if _M_IX86_FP >= 2
+#           define RAPIDCSV_SCAN_SSE2
+#       endif
+#   endif
+#endif
+
+#if defined(RAPIDCSV_SCAN_AVX2)
+#   include <immintrin.h>
+#elif defined(RAPIDCSV_SCAN_SSE2)
+#   include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+namespace rapidcsv {
+    namespace read {
+
+        // Bit i of every mask is set when byte i of a scanned block is that character
+        struct StructuralMasks {
+            std::uint64_t quote;
+            std::uint64_t sep;
+            std::uint64_t cr;
+            std::uint64_t lf;
+
+            std::uint64_t any() const {
+                return quote | sep | cr | lf;
+            }
+        };
+
+        namespace scan {
+            static constexpr std::size_t blockSize = 64;
+
+            inline unsigned trailing_zeros(std::uint64_t mask) {
+#if defined(_MSC_VER) && defined(_WIN64)
+                unsigned long index;
+                _BitScanForward64(&index, mask);
+                return static_cast<unsigned>(index);
+#elif defined(_MSC_VER)
+                unsigned long index;
+                if (_BitScanForward(&index, static_cast<unsigned long>(mask))) {
+                    return static_cast<unsigned>(index);
+                }
+                _BitScanForward(&index, static_cast<unsigned long>(mask >> 32));
+                return static_cast<unsigned>(index) + 32;
+#else
+                return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+            }
+
+            inline unsigned popcount(std::uint64_t mask) {
+#if defined(_MSC_VER)
+                mask = mask - ((mask >> 1) & 0x5555555555555555ULL);
+                mask = (mask & 0x3333333333333333ULL) + ((mask >> 2) & 0x3333333333333333ULL);
+                mask = (mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+                return static_cast<unsigned>((mask * 0x0101010101010101ULL) >> 56);
+#else
+                return static_cast<unsigned>(__builtin_popcountll(mask));
+#endif
+            }
+
+            // Mask of `byte` in the first `length` (< blockSize) bytes of `block`
+            inline std::uint64_t match_partial(const char *block, std::size_t length, char byte) {
+                std::uint64_t mask = 0;
+                for (std::size_t i = 0; i < length; ++i) {
+                    if (block[i] == byte) {
+                        mask |= static_cast<std::uint64_t>(1) << i;
+                    }
+                }
+                return mask;
+            }
+
+            // Masks for the first `length` (< blockSize) bytes of `block`
+            inline StructuralMasks scan_partial(const char *block, std::size_t length, char sep, char quote) {
+                StructuralMasks masks = {0, 0, 0, 0};
+                for (std::size_t i = 0; i < length; ++i) {
+                    const std::uint64_t bit = static_cast<std::uint64_t>(1) << i;
+                    const char byte = block[i];
+                    if (byte == quote) {
+                        masks.quote |= bit;
+                    } else if (byte == sep) {
+                        masks.sep |= bit;
+                    } else if (byte == '\r') {
+                        masks.cr |= bit;
+                    } else if (byte == '\n') {
+                        masks.lf |= bit;
+                    }
+                }
+                return masks;
+            }
+
+#if defined(RAPIDCSV_SCAN_AVX2)
+            inline std::uint64_t match_block(const __m256i &lo, const __m256i &hi, char byte) {
+                const __m256i needle = _mm256_set1_epi8(byte);
+                const std::uint64_t low = static_cast<std::uint32_t>(
+                        _mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+                const std::uint64_t high = static_cast<std::uint32_t>(
+                        _mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+                return low | (high << 32);
+            }
+
+            // Mask of `byte` in a full blockSize bytes starting at `block`
+            inline std::uint64_t match_block(const char *block, char byte) {
+                return match_block(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(block)),
+                                   _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32)), byte);
+            }
+
+            // Masks for a full blockSize bytes starting at `block`
+            inline StructuralMasks scan_block(const char *block, char sep, char quote) {
+                const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+                const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+
+                StructuralMasks masks;
+                masks.quote = match_block(lo, hi, quote);
+                masks.sep = match_block(lo, hi, sep);
+                masks.cr = match_block(lo, hi, '\r');
+                masks.lf = match_block(lo, hi, '\n');
+                return masks;
+            }
+#elif defined(RAPIDCSV_SCAN_SSE2)
+            inline std::uint64_t match_block(const __m128i (&chunks)[4], char byte) {
+                const __m128i needle = _mm_set1_epi8(byte);
+                std::uint64_t mask = 0;
+                for (unsigned i = 0; i < 4; ++i) {
+                    const std::uint64_t bits = static_cast<std::uint16_t>(
+                            _mm_movemask_epi8(_mm_cmpeq_epi8(chunks[i], needle)));
+                    mask |= bits << (16 * i);
+                }
+                return mask;
+            }
+
+            // Mask of `byte` in a full blockSize bytes starting at `block`
+            inline std::uint64_t match_block(const char *block, char byte) {
+                const __m128i chunks[4] = {
+                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block)),
+                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16)),
+                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 32)),
+                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 48))
+                };
+                return match_block(chunks, byte);
+            }
+
+            // Masks for a full blockSize bytes starting at `block`
+            inline StructuralMasks scan_block(const char *block, char sep, char quote) {
+                const __m128i chunks[4] = {
+                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block)),
+                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16)),
+                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 32)),
+                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 48))
+                };
+
+                StructuralMasks masks;
+                masks.quote = match_block(chunks, quote);
+                masks.sep = match_block(chunks, sep);
+                masks.cr = match_block(chunks, '\r');
+                masks.lf = match_block(chunks, '\n');
+                return masks;
+            }
+#else
+            // Mask of `byte` in a full blockSize bytes starting at `block`
+            inline std::uint64_t match_block(const char *block, char byte) {
+                return match_partial(block, blockSize, byte);
+            }
+
+            // Masks for a full blockSize bytes starting at `block`
+            inline StructuralMasks scan_block(const char *block, char sep, char quote) {
+                return scan_partial(block, blockSize, sep, quote);
+            }
+#endif
+
+            inline StructuralMasks scan(const char *block, std::size_t length, char sep, char quote) {
+                return length >= blockSize ? scan_block(block, sep, quote)
+                                           : scan_partial(block, length, sep, quote);
+            }
+
+            // Number of times `byte` occurs in [first, last)
+            inline std::size_t count(const char *first, const char *last, char byte) {
+                std::size_t total = 0;
+                for (; last - first >= static_cast<std::ptrdiff_t>(blockSize); first += blockSize) {
+                    total += popcount(match_block(first, byte));
+                }
+                return total + popcount(match_partial(first, static_cast<std::size_t>(last - first), byte));
+            }
+
+            // Number of line breaks in [first, last): every LF, CR and CR LF pair. `afterCR` tells whether
+            // the byte before `first` was a CR, so that a pair split between two calls counts once, and is
+            // updated for the next call
+            inline std::size_t line_breaks(const char *first, const char *last, bool &afterCR) {
+                if (first == last) {
+                    return 0;
+                }
+                const std::size_t lfs = count(first, last, '\n');
+                const std::size_t crs = count(first, last, '\r');
+                std::size_t pairs = afterCR && *first == '\n' ? 1 : 0;
+                if (crs > 0) {
+                    for (const char *at = first; at + 1 < last; ++at) {
+                        pairs += at[0] == '\r' && at[1] == '\n' ? 1 : 0;
+                    }
+                }
+                afterCR = last[-1] == '\r';
+                return lfs + crs - pairs;
+            }
+        }
+
+        // Finds structural characters (quote, field separator, CR, LF) one block at a time.
+        // The masks of the last scanned block are cached, so consecutive lookups inside
+        // the same block cost a shift and a bit scan instead of touching the bytes again.
+        // reset() must be called whenever the memory behind a previous lookup is reused.
+        //
+        // The separator and quote come from the Dialect: for a FixedDialect they are constants
+        // folded into the comparisons, and the scanner holds no copy of them.
+        template <typename Dialect>
+        class DialectScanner {
+            const char *_block;
+            std::size_t _length;
+            std::uint64_t _any, _quote;
+            Dialect _dialect;
+
+        public:
+            explicit DialectScanner(Dialect dialect = Dialect()) :
+                    _block(nullptr), _length(0), _any(0), _quote(0), _dialect(dialect) {}
+
+            // First quote, separator, CR or LF in [from, last), last if there is none
+            const char *find(const char *from, const char *last) {
+                return find(from, last, false);
+            }
+
+            // First quote in [from, last), last if there is none
+            const char *find_quote(const char *from, const char *last) {
+                return find(from, last, true);
+            }
+
+            void reset() {
+                _block = nullptr;
+                _length = 0;
+                _any = _quote = 0;
+            }
+
+        private:
+            const char *find(const char *from, const char *last, bool quoteOnly) {
+                if (_block == nullptr || from < _block || from >= _block + _length) {
+                    load(from, last);
+                }
+
+                while (true) {
+                    const auto offset = static_cast<std::size_t>(from - _block);
+                    const std::uint64_t mask = (quoteOnly ? _quote : _any) & (~static_cast<std::uint64_t>(0) << offset);
+                    if (mask != 0) {
+                        const char *hit = _block + scan::trailing_zeros(mask);
+                        return hit < last ? hit : last;
+                    }
+
+                    from = _block + _length;
+                    if (from >= last) {
+                        return last;
+                    }
+                    load(from, last);
+                }
+            }
+
+            void load(const char *from, const char *last) {
+                const auto remaining = static_cast<std::size_t>(last - from);
+                const StructuralMasks masks = scan::scan(from, remaining, _dialect.sep(), _dialect.quote());
+
+                _block = from;
+                _length = remaining < scan::blockSize ? remaining : scan::blockSize;
+                _any = masks.any();
+                _quote = masks.quote;
+            }
+        };
+
+        // Scanner for a separator and quote known only at run time
+        class StructuralScanner: public DialectScanner<RuntimeDialect> {
+        public:
+            explicit StructuralScanner(char sep = ',', char quote = '"') :
+                    DialectScanner<RuntimeDialect>(RuntimeDialect(sep, quote)) {}
+        };
+    }
+}
+
+#endif //RAPIDCSV_SCANNER_HPP
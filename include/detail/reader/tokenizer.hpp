@@ -0,0 +1,144 @@
+#ifndef RAPIDCSV_TOKENIZER_HPP
+#define RAPIDCSV_TOKENIZER_HPP
+
+#include <cstdint>
+#include "dialect.hpp"
+#include "detail/csv_constants.hpp"
+
+namespace rapidcsv {
+    namespace read {
+        namespace token {
+
+            // What a byte means to the tokenizer, looked up in a CharClassTable
+            enum Class : std::uint8_t {
+                DATA,
+                SEP,
+                QUOTE,
+                // Row separator: LF, unless rows are separated by CR only
+                ROW_END,
+                // CR where it separates rows; an LF right after it belongs to the same separator
+                CR_END,
+                // CR where only LF separates rows; it separates rows only as part of CR LF
+                CR_BEFORE_LF,
+                CLASSES
+            };
+
+            // Where the tokenizer is within the current field
+            enum State : std::uint8_t {
+                FIELD_START,
+                UNQUOTED,
+                QUOTED,
+                // A quote inside a quoted field, either the closing quote or the first of a doubled one
+                QUOTE_CLOSED,
+                STATES
+            };
+
+            enum Action : std::uint8_t {
+                APPEND,
+                // Doubled quote, the first of the pair was kept already
+                SKIP,
+                END_FIELD,
+                END_ROW,
+                END_ROW_CR,
+                // Ends the row when the next byte is LF, otherwise the CR is data
+                PEEK_LF,
+                QUOTE_IN_UNQUOTED,
+                UNESCAPED_QUOTE
+            };
+
+            struct Transition {
+                State next;
+                Action action;
+            };
+
+            // transitions[state][class]
+            static constexpr Transition transitions[STATES][CLASSES] = {
+                    // FIELD_START
+                    {{UNQUOTED, APPEND}, {FIELD_START, END_FIELD}, {QUOTED, APPEND},
+                            {FIELD_START, END_ROW}, {FIELD_START, END_ROW_CR}, {UNQUOTED, PEEK_LF}},
+                    // UNQUOTED
+                    {{UNQUOTED, APPEND}, {FIELD_START, END_FIELD}, {UNQUOTED, QUOTE_IN_UNQUOTED},
+                            {FIELD_START, END_ROW}, {FIELD_START, END_ROW_CR}, {UNQUOTED, PEEK_LF}},
+                    // QUOTED
+                    {{QUOTED, APPEND}, {QUOTED, APPEND}, {QUOTE_CLOSED, APPEND},
+                            {QUOTED, APPEND}, {QUOTED, APPEND}, {QUOTED, APPEND}},
+                    // QUOTE_CLOSED
+                    {{QUOTE_CLOSED, UNESCAPED_QUOTE}, {FIELD_START, END_FIELD}, {QUOTED, SKIP},
+                            {FIELD_START, END_ROW}, {FIELD_START, END_ROW_CR}, {QUOTE_CLOSED, PEEK_LF}}
+            };
+        }
+
+        // Class of every byte value for one dialect, so that custom dialects tokenize exactly as fast
+        // as the default one
+        class CharClassTable {
+            std::uint8_t _classes[256];
+
+        public:
+            template <typename Dialect>
+            explicit CharClassTable(const Dialect &dialect) {
+                for (auto &byteClass : _classes) {
+                    byteClass = token::DATA;
+                }
+
+                _classes[index(CR)] = dialect.crEndsRow() ? token::CR_END : token::CR_BEFORE_LF;
+                if (dialect.lfEndsRow()) {
+                    _classes[index(LF)] = token::ROW_END;
+                }
+                _classes[index(dialect.sep())] = token::SEP;
+                _classes[index(dialect.quote())] = token::QUOTE;
+            }
+
+            token::Class operator[](char byte) const {
+                return static_cast<token::Class>(_classes[index(byte)]);
+            }
+
+        private:
+            static std::uint8_t index(char byte) {
+                return static_cast<std::uint8_t>(byte);
+            }
+        };
+
+        // The CharClassTable a reader looks bytes up in. A dialect known only at run time gets its own
+        // table, built with the reader
+        template <typename Dialect>
+        class DialectClasses {
+            CharClassTable _table;
+
+        public:
+            explicit DialectClasses(const Dialect &dialect) : _table(dialect) {}
+
+            token::Class operator[](char byte) const {
+                return _table[byte];
+            }
+
+            const CharClassTable &table() const {
+                return _table;
+            }
+        };
+
+        // Every reader of a FixedDialect shares one table, built the first time one is constructed
+        template <char Sep, char Quote, RowSepType RowSep>
+        class DialectClasses<FixedDialect<Sep, Quote, RowSep>> {
+            const CharClassTable *_table;
+
+        public:
+            explicit DialectClasses(const FixedDialect<Sep, Quote, RowSep> &) : _table(&shared()) {}
+
+            token::Class operator[](char byte) const {
+                return (*_table)[byte];
+            }
+
+            const CharClassTable &table() const {
+                return *_table;
+            }
+
+        private:
+            static const CharClassTable &shared() {
+                static const CharClassTable table{FixedDialect<Sep, Quote, RowSep>()};
+                return table;
+            }
+        };
+    }
+}
+
+#endif //RAPIDCSV_TOKENIZER_HPP
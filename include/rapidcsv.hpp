@@ -1,26 +1,11 @@
 #pragma once
 
+#include "detail/csv_constants.hpp"
 #include "detail/document/document.hpp"
+#include "detail/document/lazy_document.hpp"
+#include "detail/csv_document.hpp"
 
 namespace rapidcsv {
     using doc::Document;
-
-    //////////////////////////////////////////////////////////
-    /////////////////////// CONSTANTS ////////////////////////
-    //////////////////////////////////////////////////////////
-
-    static constexpr char CR = '\r';
-    static constexpr char LF = '\n';
-    static constexpr const char CRLF[3] = "\r\n";
-    static constexpr auto bufLength = 64 * 1024;
-
-    //////////////////////////////////////////////////////////
-    //////////////////////// DOCUMENT ////////////////////////
-    //////////////////////////////////////////////////////////
-
-    void save(const Document& document);
-    void save(const Document& document, const std::string& path);
-
-    Document&& load(const Properties &properties);
-    Document&& load(const std::string& path);
+    using doc::CSVDocument;
 }
@@ -0,0 +1,56 @@
+// test045.cpp - structural character scanner
+
+#include <iostream>
+#include <string>
+#include <detail/reader/scanner.hpp>
+#include "unittest.h"
+
+int main() {
+    int rv = 0;
+
+    std::string csv =
+            "Date,Open,High,Low,Close,Volume,Adj Close\r\n"
+                    "2017-02-24,64.529999,64.800003,64.139999,64.620003,21705200,64.620003\r\n"
+                    "\"quoted, with a separator\",\"and \"\"escaped\"\" quotes\"\n";
+
+    try {
+        rapidcsv::read::StructuralMasks masks = rapidcsv::read::scan::scan(csv.data(), csv.size(), ',', '"');
+        unittest::ExpectEqual(unsigned, rapidcsv::read::scan::trailing_zeros(masks.sep), 4);
+        unittest::ExpectEqual(unsigned, rapidcsv::read::scan::trailing_zeros(masks.cr), 41);
+        unittest::ExpectEqual(unsigned, rapidcsv::read::scan::trailing_zeros(masks.lf), 42);
+        unittest::ExpectTrue(masks.quote == 0);
+
+        // Every structural character is found in order, across block boundaries
+        rapidcsv::read::StructuralScanner scanner(',', '"');
+        const char *last = csv.data() + csv.size();
+        const char *hit = csv.data();
+        for (std::size_t i = 0; i < csv.size(); ++i) {
+            char byte = csv[i];
+            if (byte != ',' && byte != '"' && byte != '\r' && byte != '\n') {
+                continue;
+            }
+            hit = scanner.find(hit, last);
+            unittest::ExpectEqual(std::size_t, static_cast<std::size_t>(hit - csv.data()), i);
+            ++hit;
+        }
+        unittest::ExpectTrue(scanner.find(hit, last) == last);
+
+        // Quote-only lookups skip separators and line breaks
+        std::size_t firstQuote = csv.find('"');
+        unittest::ExpectEqual(std::size_t,
+                              static_cast<std::size_t>(scanner.find_quote(csv.data(), last) - csv.data()), firstQuote);
+        unittest::ExpectEqual(std::size_t,
+                              static_cast<std::size_t>(scanner.find_quote(csv.data() + firstQuote + 1, last) - csv.data()),
+                              csv.find('"', firstQuote + 1));
+
+        // A lookup never reports a match past the requested end
+        scanner.reset();
+        unittest::ExpectTrue(scanner.find(csv.data(), csv.data() + 4) == csv.data() + 4);
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
@@ -0,0 +1,47 @@
+// test046.cpp - fields spanning block boundaries
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <detail/reader/row_reader.hpp>
+#include "unittest.h"
+
+int main() {
+    int rv = 0;
+
+    std::string csv =
+            "-,A,B,C\r\n"
+                    "1,\"quoted, across\r\nlines\",\"say \"\"hi\"\"\",81\r\n"
+                    "2,4,16,256\n";
+
+    try {
+        std::vector<std::vector<std::string>> expected;
+        {
+            rapidcsv::read::CSVRowReader reader(csv.data(), csv.data() + csv.size());
+            while (reader.has_next()) {
+                expected.push_back(reader.next());
+            }
+        }
+        unittest::ExpectEqual(std::size_t, expected.size(), 3);
+        unittest::ExpectEqual(std::string, expected[1][1], "\"quoted, across\r\nlines\"");
+        unittest::ExpectEqual(std::string, expected[2][3], "256");
+
+        for (std::size_t blockSize = 1; blockSize <= csv.size(); ++blockSize) {
+            std::istringstream stream(csv);
+            rapidcsv::read::CSVRowReader reader(rapidcsv::read::blockReader(stream, blockSize));
+
+            std::vector<std::vector<std::string>> rows;
+            while (reader.has_next()) {
+                rows.push_back(reader.next());
+            }
+            unittest::ExpectTrue(rows == expected);
+        }
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
@@ -0,0 +1,53 @@
+// test047.cpp - zero-copy field views
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <detail/reader/field_view_reader.hpp>
+#include "unittest.h"
+
+int main() {
+    int rv = 0;
+
+    std::string csv =
+            "Date,Close,\"Note\"\n"
+                    "2017-02-24,64.620003,\"said \"\"hi\"\"\"\n";
+
+    try {
+        const char *first = csv.data();
+        const char *last = csv.data() + csv.size();
+        rapidcsv::read::CSVFieldViewReader reader(first, last);
+
+        std::vector<std::string> fields;
+        std::vector<bool> borrowed;
+        std::size_t rows = 0;
+        while (reader.has_next()) {
+            rapidcsv::read::FieldView field = reader.next();
+            if (reader.row_end()) {
+                ++rows;
+                continue;
+            }
+            fields.push_back(field.str());
+            borrowed.push_back(field.data >= first && field.data < last);
+        }
+
+        unittest::ExpectEqual(std::size_t, rows, 2);
+        unittest::ExpectEqual(std::size_t, fields.size(), 6);
+        unittest::ExpectEqual(std::string, fields[0], "Date");
+        unittest::ExpectEqual(std::string, fields[2], "Note");
+        unittest::ExpectEqual(std::string, fields[4], "64.620003");
+        unittest::ExpectEqual(std::string, fields[5], "said \"hi\"");
+
+        // Only the field with doubled quotes had to be copied
+        for (std::size_t i = 0; i < 5; ++i) {
+            unittest::ExpectTrue(borrowed[i]);
+        }
+        unittest::ExpectTrue(!borrowed[5]);
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
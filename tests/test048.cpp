@@ -0,0 +1,59 @@
+// test048.cpp - parse from a memory mapped file
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <detail/reader/mapped_file.hpp>
+#include <detail/reader/row_reader.hpp>
+#include <detail/document/properties.hpp>
+#include "unittest.h"
+
+int main() {
+    int rv = 0;
+
+    std::string csv =
+            "-,A,B,C\n"
+                    "1,3,9,81\n"
+                    "2,4,16,\"256\"\n";
+
+    std::string path = unittest::TempPath();
+    unittest::WriteFile(path, csv);
+
+    try {
+        rapidcsv::Properties properties = rapidcsv::PropertiesBuilder()
+                .filePath(path)
+                .loadMode(rapidcsv::LoadMode::MMAP)
+                .keepMapping();
+        unittest::ExpectTrue(properties.loadMode() == rapidcsv::LoadMode::MMAP);
+        unittest::ExpectTrue(properties.keepMapping());
+
+        std::shared_ptr<const rapidcsv::read::MappedFile> mapping = rapidcsv::read::mapFile(properties.filePath());
+        unittest::ExpectEqual(std::size_t, mapping->size(), csv.size());
+        unittest::ExpectEqual(std::string, std::string(mapping->begin(), mapping->end()), csv);
+
+        rapidcsv::read::CSVRowReader reader(rapidcsv::read::blockReader(mapping->begin(), mapping->end()));
+        std::vector<std::vector<std::string>> rows;
+        while (reader.has_next()) {
+            rows.push_back(reader.next());
+        }
+        unittest::ExpectEqual(std::size_t, rows.size(), 3);
+        unittest::ExpectEqual(std::string, rows[1][3], "81");
+        unittest::ExpectEqual(std::string, rows[2][3], "\"256\"");
+
+        bool thrown = false;
+        try {
+            rapidcsv::read::mapFile(path + ".missing");
+        } catch (const rapidcsv::read::csv_file_map_exception &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    unittest::DeleteFile(path);
+
+    return rv;
+}
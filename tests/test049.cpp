@@ -0,0 +1,76 @@
+// test049.cpp - split the input across threads and parse it in parallel
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <detail/reader/parallel_reader.hpp>
+#include <detail/document/properties.hpp>
+#include "unittest.h"
+
+using Rows = std::vector<std::vector<std::string>>;
+
+static Rows parse(const std::string &csv) {
+    rapidcsv::read::CSVRowReader reader(rapidcsv::read::blockReader(csv.data(), csv.data() + csv.size()));
+    Rows rows;
+    while (reader.has_next()) {
+        rows.push_back(reader.next());
+    }
+    return rows;
+}
+
+int main() {
+    int rv = 0;
+
+    // Quoted fields hold separators and line breaks, so most split points land inside one
+    std::string csv = "-,A,B,C\r\n";
+    for (int i = 0; i < 200; ++i) {
+        const std::string n = std::to_string(i);
+        csv += n + ",\"x\n" + n + "\",\"\"\"q\"\"\"," + (i % 3 == 0 ? "\"a,\r\nb\"" : n) + (i % 2 ? "\n" : "\r\n");
+    }
+
+    try {
+        const Rows expected = parse(csv);
+        unittest::ExpectEqual(std::size_t, expected.size(), 201);
+
+        for (std::size_t threads : {2, 3, 4, 7, 16}) {
+            const Rows rows = rapidcsv::read::parallel_parse(csv.data(), csv.data() + csv.size(), threads, 1);
+            unittest::ExpectTrue(rows == expected);
+        }
+
+        const Rows all = rapidcsv::read::parallel_parse(csv.data(), csv.data() + csv.size(), 0, 16);
+        unittest::ExpectTrue(all == expected);
+
+        // Inputs without quotes, ranges inside one long quoted field, CR LF pairs cut between two ranges
+        std::string plain, spanning = "k,\"" + std::string(300, 'x') + "\r\n" + std::string(300, 'y') + "\"\r\n";
+        for (int i = 0; i < 60; ++i) {
+            plain += std::to_string(i) + ",a,bc\r\n";
+            spanning += std::to_string(i) + (i % 20 == 0 ? ",\"" + std::string(200, ',') + "\"\r\n" : ",z\r\n");
+        }
+        for (const std::string &input : {plain, spanning}) {
+            const Rows inputRows = parse(input);
+            for (std::size_t threads = 2; threads <= 24; ++threads) {
+                const Rows rows = rapidcsv::read::parallel_parse(input.data(), input.data() + input.size(), threads, 1);
+                unittest::ExpectTrue(rows == inputRows);
+            }
+        }
+
+        const std::string bad = csv + "1,\"unterminated\n";
+        bool thrown = false;
+        try {
+            rapidcsv::read::parallel_parse(bad.data(), bad.data() + bad.size(), 4, 1);
+        } catch (const rapidcsv::except::csv_unterminated_quote_exception &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+
+        rapidcsv::Properties properties = rapidcsv::PropertiesBuilder().threads(4);
+        unittest::ExpectEqual(std::size_t, properties.parseThreads(), 4);
+        unittest::ExpectEqual(std::size_t, rapidcsv::Properties().parseThreads(), 1);
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
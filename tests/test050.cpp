@@ -0,0 +1,71 @@
+// test050.cpp - row offset index and random access to rows
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <detail/reader/row_index.hpp>
+#include "unittest.h"
+
+int main() {
+    int rv = 0;
+
+    std::string csv = "-,A,B\r\n";
+    for (int i = 0; i < 1000; ++i) {
+        const std::string n = std::to_string(i);
+        csv += n + "," + (i % 4 == 0 ? "\"multi\r\nline\"" : n) + ",\"" + n + "\"\"\"" + (i % 3 ? "\n" : "\r");
+    }
+
+    std::string path = unittest::TempPath();
+    unittest::WriteFile(path, csv);
+
+    try {
+        rapidcsv::read::CSVRowReader reader(rapidcsv::read::blockReader(csv.data(), csv.data() + csv.size()));
+        std::vector<std::vector<std::string>> expected;
+        while (reader.has_next()) {
+            expected.push_back(reader.next());
+        }
+
+        using rapidcsv::read::IndexEncoding;
+        auto plain = rapidcsv::read::indexRows(csv.data(), csv.data() + csv.size());
+        auto delta = rapidcsv::read::indexRows(csv.data(), csv.data() + csv.size(), IndexEncoding::DELTA);
+        unittest::ExpectEqual(std::size_t, plain.size(), 1001);
+        unittest::ExpectEqual(std::size_t, delta.size(), 1001);
+        unittest::ExpectTrue(delta.memory() < plain.memory());
+        unittest::ExpectEqual(std::uint64_t, plain.offset(1), 7);
+        for (std::size_t row = 0; row < plain.size(); ++row) {
+            unittest::ExpectEqual(std::uint64_t, delta.offset(row), plain.offset(row));
+        }
+        unittest::ExpectEqual(std::uint64_t, plain.end_offset(1000), csv.size());
+
+        auto rows = rapidcsv::read::readRows(csv.data(), delta, 500, 3);
+        unittest::ExpectEqual(std::size_t, rows.size(), 3);
+        unittest::ExpectTrue(rows[0] == expected[500]);
+        unittest::ExpectTrue(rows[2] == expected[502]);
+
+        for (bool mapped : {false, true}) {
+            rapidcsv::read::IndexedFile file(path, mapped, IndexEncoding::DELTA, 100);
+            unittest::ExpectEqual(std::size_t, file.size(), expected.size());
+            unittest::ExpectTrue(file.row(1000) == expected[1000]);
+            unittest::ExpectTrue(file.row(1) == expected[1]);
+            unittest::ExpectEqual(std::string, file.row(1)[1], "\"multi\r\nline\"");
+            auto range = file.rows(997, 4);
+            unittest::ExpectTrue(range == std::vector<std::vector<std::string>>(expected.begin() + 997, expected.end()));
+        }
+
+        bool thrown = false;
+        try {
+            plain.offset(1001);
+        } catch (const std::out_of_range &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    unittest::DeleteFile(path);
+
+    return rv;
+}
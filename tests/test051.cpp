@@ -0,0 +1,63 @@
+// test051.cpp - parse rows on first access and cache them with a memory limit
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <detail/reader/row_cache.hpp>
+#include <detail/document/properties.hpp>
+#include "unittest.h"
+
+int main() {
+    int rv = 0;
+
+    std::string csv;
+    for (int i = 0; i < 100; ++i) {
+        const std::string n = std::to_string(i);
+        csv += n + ",\"" + std::string(40, 'x') + "\n" + n + "\"," + n + "\n";
+    }
+
+    std::string path = unittest::TempPath();
+    unittest::WriteFile(path, csv);
+
+    try {
+        for (bool mapped : {false, true}) {
+            // Room for about two blocks of ten rows
+            rapidcsv::read::RowCache cache(rapidcsv::read::IndexedFile(path, mapped), 2500, 10);
+            unittest::ExpectEqual(std::size_t, cache.size(), 100);
+            unittest::ExpectEqual(std::size_t, cache.blocks(), 0);
+
+            unittest::ExpectEqual(std::string, cache.row(42)[0], "42");
+            unittest::ExpectEqual(std::string, cache.row(45)[2], "45");
+            unittest::ExpectEqual(std::size_t, cache.misses(), 1);
+            unittest::ExpectEqual(std::size_t, cache.hits(), 1);
+
+            unittest::ExpectEqual(std::string, cache.row(99)[2], "99");
+            unittest::ExpectEqual(std::string, cache.row(0)[2], "0");
+            unittest::ExpectTrue(cache.memory() <= 2500);
+            unittest::ExpectTrue(cache.blocks() < 3);
+
+            // Evicted blocks are parsed again
+            unittest::ExpectEqual(std::string, cache.row(41)[1], "\"" + std::string(40, 'x') + "\n41\"");
+            unittest::ExpectEqual(std::size_t, cache.misses(), 4);
+
+            bool thrown = false;
+            try {
+                cache.row(100);
+            } catch (const std::out_of_range &) {
+                thrown = true;
+            }
+            unittest::ExpectTrue(thrown);
+        }
+
+        rapidcsv::Properties properties = rapidcsv::PropertiesBuilder().cacheLimit(1024);
+        unittest::ExpectEqual(std::size_t, properties.cacheLimit(), 1024);
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    unittest::DeleteFile(path);
+
+    return rv;
+}
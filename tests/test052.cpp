@@ -0,0 +1,72 @@
+// test052.cpp - dialect specialized readers
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <detail/reader/row_reader.hpp>
+#include "unittest.h"
+
+using Rows = std::vector<std::vector<std::string>>;
+
+static Rows parse(std::unique_ptr<rapidcsv::read::Reader<rapidcsv::read::VS>> reader) {
+    Rows rows;
+    while (reader->has_next()) {
+        rows.push_back(reader->next());
+    }
+    return rows;
+}
+
+static Rows parse(const std::string &csv, char sep, char quote, rapidcsv::RowSepType rowSep) {
+    using rapidcsv::read::blockReader;
+    return parse(rapidcsv::read::rowReader(blockReader(csv.data(), csv.data() + csv.size()), sep, quote, rowSep));
+}
+
+int main() {
+    int rv = 0;
+
+    using rapidcsv::RowSepType;
+
+    try {
+        // Tab separated, commas are data
+        Rows rows = parse("a,b\t\"c\td\"\n1\t2\n", '\t', '"', RowSepType::LF);
+        unittest::ExpectEqual(std::size_t, rows.size(), 2);
+        unittest::ExpectEqual(std::string, rows[0][0], "a,b");
+        unittest::ExpectEqual(std::string, rows[0][1], "\"c\td\"");
+        unittest::ExpectEqual(std::string, rows[1][1], "2");
+
+        // LF rows accept CR LF, a lone CR is data
+        rows = parse("a;b\r\nc\rd;e\n", ';', '"', RowSepType::LF);
+        unittest::ExpectEqual(std::size_t, rows.size(), 2);
+        unittest::ExpectEqual(std::string, rows[0][1], "b");
+        unittest::ExpectEqual(std::string, rows[1][0], "c\rd");
+
+        // CR rows accept CR LF, a lone LF is data
+        rows = parse("a|b\rc\nd|e\r\nf", '|', '"', RowSepType::CR);
+        unittest::ExpectEqual(std::size_t, rows.size(), 3);
+        unittest::ExpectEqual(std::string, rows[1][0], "c\nd");
+        unittest::ExpectEqual(std::string, rows[2][0], "f");
+
+        // CRLF rows split on any of CR, LF and CR LF, like CSVFieldReader
+        rows = parse("a,b\rc\nd\r\ne", ',', '"', RowSepType::CRLF);
+        unittest::ExpectEqual(std::size_t, rows.size(), 4);
+
+        // Uncommon dialects fall back to a run time dialect
+        rows = parse("'a:b':c\n'x''y':z\n", ':', '\'', RowSepType::LF);
+        unittest::ExpectEqual(std::size_t, rows.size(), 2);
+        unittest::ExpectEqual(std::string, rows[0][0], "'a:b'");
+        unittest::ExpectEqual(std::string, rows[1][0], "'x'y'");
+        unittest::ExpectEqual(std::string, rows[1][1], "z");
+
+        std::string csv = "1\t2\n3\t4\n";
+        rapidcsv::read::BasicRowReader<'\t', '"', RowSepType::LF> reader(csv.begin(), csv.end());
+        unittest::ExpectTrue(reader.next() == std::vector<std::string>({"1", "2"}));
+        unittest::ExpectTrue(reader.next() == std::vector<std::string>({"3", "4"}));
+        unittest::ExpectTrue(!reader.has_next());
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
@@ -0,0 +1,84 @@
+// test053.cpp - table driven tokenizer and custom dialects
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <detail/reader/field_reader.hpp>
+#include <detail/reader/field_view_reader.hpp>
+#include <detail/reader/row_index.hpp>
+#include "unittest.h"
+
+int main() {
+    int rv = 0;
+
+    using rapidcsv::RowSepType;
+    using namespace rapidcsv::read;
+
+    try {
+        // Character classes follow the dialect
+        CharClassTable classes(RuntimeDialect(':', '\'', RowSepType::LF));
+        unittest::ExpectTrue(classes[':'] == token::SEP);
+        unittest::ExpectTrue(classes['\''] == token::QUOTE);
+        unittest::ExpectTrue(classes[','] == token::DATA);
+        unittest::ExpectTrue(classes['"'] == token::DATA);
+        unittest::ExpectTrue(classes['\n'] == token::ROW_END);
+        unittest::ExpectTrue(classes['\r'] == token::CR_BEFORE_LF);
+
+        CharClassTable crClasses(RuntimeDialect(',', '"', RowSepType::CR));
+        unittest::ExpectTrue(crClasses['\r'] == token::CR_END);
+        unittest::ExpectTrue(crClasses['\n'] == token::DATA);
+
+        // Readers of a FixedDialect share one table instead of building their own
+        const DialectClasses<CSVDialect> shared((CSVDialect())), other((CSVDialect()));
+        unittest::ExpectTrue(&shared.table() == &other.table());
+        unittest::ExpectTrue(shared['"'] == token::QUOTE);
+        unittest::ExpectTrue(sizeof(DialectClasses<CSVDialect>) < sizeof(CharClassTable));
+
+        // A closing quote followed by data is an unescaped quote
+        unittest::ExpectTrue(token::transitions[token::QUOTED][token::QUOTE].next == token::QUOTE_CLOSED);
+        unittest::ExpectTrue(token::transitions[token::QUOTE_CLOSED][token::QUOTE].action == token::SKIP);
+        unittest::ExpectTrue(token::transitions[token::QUOTE_CLOSED][token::DATA].action == token::UNESCAPED_QUOTE);
+
+        // Field reader with a custom separator and quote
+        const std::string csv = "'a:b':c,d\r\n'x''y':\"z\"\n";
+        const RuntimeDialect dialect(':', '\'', RowSepType::LF);
+        DialectFieldReader<RuntimeDialect> fields(csv.begin(), csv.end(), 3, dialect);
+        std::vector<std::string> tokens;
+        while (fields.has_next()) {
+            tokens.push_back(fields.next());
+        }
+        unittest::ExpectTrue(tokens == std::vector<std::string>({"'a:b'", "c,d", "\n", "'x'y'", "\"z\"", "\n"}));
+
+        // View reader strips the quotes
+        DialectFieldViewReader<RuntimeDialect> views(csv.begin(), csv.end(), 4, dialect);
+        tokens.clear();
+        while (views.has_next()) {
+            const FieldView view = views.next();
+            tokens.push_back(views.row_end() ? "\n" : view.str());
+        }
+        unittest::ExpectTrue(tokens == std::vector<std::string>({"a:b", "c,d", "\n", "x'y", "\"z\"", "\n"}));
+
+        const std::string bad = "a'b";
+        bool thrown = false;
+        try {
+            DialectFieldReader<RuntimeDialect>(bad.begin(), bad.end(), rapidcsv::bufLength, dialect).next();
+        } catch (const rapidcsv::except::csv_quote_inside_non_quote_field_exception &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+
+        // Row index and row reads honour the dialect, the LF inside the quotes stays in its row
+        const std::string rows = "'1\n2':3\r\n4:5\n";
+        const RowIndex index = indexRows(rows.data(), rows.data() + rows.size(), IndexEncoding::PLAIN, dialect);
+        unittest::ExpectEqual(std::size_t, index.size(), 2);
+        unittest::ExpectEqual(std::size_t, index.offset(1), 9);
+        const std::vector<VS> second = readRows(rows.data(), index, 1, 1, dialect);
+        unittest::ExpectTrue(second.front() == VS({"4", "5"}));
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
@@ -0,0 +1,106 @@
+// test054.cpp - error policies and diagnostics
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <detail/reader/row_reader.hpp>
+#include <detail/reader/parallel_reader.hpp>
+#include "unittest.h"
+
+using Rows = std::vector<std::vector<std::string>>;
+
+static Rows parse(const std::string &csv, rapidcsv::ErrorPolicy policy, rapidcsv::read::Diagnostics *diagnostics) {
+    using rapidcsv::read::blockReader;
+    auto reader = rapidcsv::read::rowReader(blockReader(csv.data(), csv.data() + csv.size(), 4), ',', '"',
+                                            rapidcsv::RowSepType::CRLF, policy, diagnostics);
+    Rows rows;
+    while (reader->has_next()) {
+        rows.push_back(reader->next());
+    }
+    return rows;
+}
+
+int main() {
+    int rv = 0;
+
+    using rapidcsv::ErrorPolicy;
+    using rapidcsv::read::ParseError;
+    using rapidcsv::read::Diagnostics;
+
+    try {
+        // Rows 2 and 4 are malformed, so is the last one
+        const std::string csv = "a,b\n1,x\"y\n2,3\n\"4\"5,6\n7,8\n\"9,";
+
+        bool thrown = false;
+        try {
+            parse(csv, ErrorPolicy::THROW, nullptr);
+        } catch (const rapidcsv::except::csv_quote_inside_non_quote_field_exception &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+
+        Rows rows = parse(csv, ErrorPolicy::SKIP_ROW, nullptr);
+        unittest::ExpectTrue(rows == Rows({{"a", "b"}, {"2", "3"}, {"7", "8"}}));
+
+        rows = parse(csv, ErrorPolicy::KEEP_RAW, nullptr);
+        unittest::ExpectEqual(std::size_t, rows.size(), 6);
+        unittest::ExpectEqual(std::string, rows[1][1], "x\"y");
+        unittest::ExpectEqual(std::string, rows[3][0], "\"4\"5");
+        unittest::ExpectEqual(std::string, rows[5][0], "\"9,");
+
+        Diagnostics diagnostics;
+        rows = parse(csv, ErrorPolicy::COLLECT, &diagnostics);
+        unittest::ExpectTrue(rows == Rows({{"a", "b"}, {"2", "3"}, {"7", "8"}}));
+        unittest::ExpectEqual(std::size_t, diagnostics.size(), 3);
+
+        unittest::ExpectTrue(diagnostics[0].error == ParseError::QUOTE_INSIDE_NON_QUOTE_FIELD);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[0].offset, 7);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[0].line, 2);
+        unittest::ExpectEqual(std::uint32_t, diagnostics[0].column, 2);
+
+        unittest::ExpectTrue(diagnostics[1].error == ParseError::UNESCAPED_QUOTE);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[1].offset, 17);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[1].line, 4);
+        unittest::ExpectEqual(std::uint32_t, diagnostics[1].column, 1);
+
+        unittest::ExpectTrue(diagnostics[2].error == ParseError::UNTERMINATED_QUOTE);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[2].offset, 25);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[2].line, 6);
+        unittest::ExpectEqual(std::size_t, diagnostics.count(ParseError::UNESCAPED_QUOTE), 1);
+
+        // Lines count the line breaks inside quoted fields too, a CR LF split between two blocks once
+        diagnostics.clear();
+        rows = parse("k,\"\r\nb\"\r\n2,x\"y\n", ErrorPolicy::COLLECT, &diagnostics);
+        unittest::ExpectTrue(rows == Rows({{"k", "\"\r\nb\""}}));
+        unittest::ExpectEqual(std::size_t, diagnostics.size(), 1);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[0].offset, 12);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[0].line, 3);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[0].row, 2);
+
+        // Parallel parsing reports the same diagnostics, relative to the whole input
+        std::string big;
+        for (int i = 0; i < 500; ++i) {
+            big += i % 7 == 3 ? "1,x\"y\n" : "\"1\n2\",3\n";
+        }
+        Diagnostics serial, parallel;
+        rows = parse(big, ErrorPolicy::COLLECT, &serial);
+        const Rows parallelRows = rapidcsv::read::parallel_parse(big.data(), big.data() + big.size(), ',', '"',
+                                                                 rapidcsv::RowSepType::CRLF, 4, 64,
+                                                                 ErrorPolicy::COLLECT, &parallel);
+        unittest::ExpectTrue(rows == parallelRows);
+        unittest::ExpectEqual(std::uint64_t, serial[0].row, 4);
+        unittest::ExpectEqual(std::uint64_t, serial[0].line, 7);
+        unittest::ExpectEqual(std::size_t, serial.size(), parallel.size());
+        for (std::size_t i = 0; i < serial.size(); ++i) {
+            unittest::ExpectEqual(std::uint64_t, serial[i].offset, parallel[i].offset);
+            unittest::ExpectEqual(std::uint64_t, serial[i].line, parallel[i].line);
+            unittest::ExpectEqual(std::uint64_t, serial[i].row, parallel[i].row);
+        }
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
@@ -0,0 +1,98 @@
+// test055.cpp - push parser fed in fragments
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <detail/reader/push_parser.hpp>
+#include "unittest.h"
+
+using Rows = std::vector<std::vector<std::string>>;
+
+int main() {
+    int rv = 0;
+
+    using rapidcsv::RowSepType;
+    using namespace rapidcsv::read;
+
+    try {
+        const std::string csv = "a,\"b\r\n\"\"c\",d\r\n1,2\r\n,3";
+        const Rows expected = {{"a", "\"b\r\n\"c\"", "d"}, {"1", "2"}, {"", "3"}};
+
+        // Fragments of every size, including ones that split the quoted field, the doubled quote
+        // and the CR LF pairs
+        for (std::size_t size = 1; size <= csv.size(); ++size) {
+            CSVPushParser parser;
+            Rows rows;
+            for (std::size_t at = 0; at < csv.size(); at += size) {
+                parser.feed(csv.data() + at, std::min(size, csv.size() - at));
+                while (parser.has_next()) {
+                    rows.push_back(parser.next());
+                }
+            }
+            unittest::ExpectEqual(std::size_t, rows.size(), 2);
+            parser.finish();
+            rows.push_back(parser.next());
+            unittest::ExpectTrue(rows == expected);
+            unittest::ExpectTrue(!parser.has_next());
+        }
+
+        // Rows are emitted as soon as they close
+        BasicPushParser<';', '"', RowSepType::LF> parser;
+        parser.feed("x;y");
+        unittest::ExpectEqual(std::size_t, parser.pending(), 0);
+        parser.feed("\nz");
+        unittest::ExpectEqual(std::size_t, parser.pending(), 1);
+        unittest::ExpectTrue(parser.next() == VS({"x", "y"}));
+        parser.feed("\r");
+        unittest::ExpectEqual(std::size_t, parser.pending(), 0);
+        parser.feed("\n");
+        unittest::ExpectTrue(parser.next() == VS({"z"}));
+
+        // A lone CR is data for LF rows, even when it ends a fragment
+        parser.feed("1\r");
+        parser.feed("2;3");
+        parser.finish();
+        unittest::ExpectTrue(parser.next() == VS({"1\r2", "3"}));
+
+        // Errors are thrown by the feed that reaches them, unless the policy says otherwise
+        bool thrown = false;
+        try {
+            CSVPushParser strict;
+            strict.feed("1,\"2\"");
+            strict.feed("x\n");
+        } catch (const rapidcsv::except::csv_unescaped_quote_exception &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+
+        Diagnostics diagnostics;
+        CSVPushParser lenient(CSVDialect(), rapidcsv::ErrorPolicy::COLLECT, &diagnostics);
+        lenient.feed("1,\"2\"");
+        lenient.feed("x\n3,4\n\"5");
+        lenient.finish();
+        unittest::ExpectTrue(lenient.next() == VS({"3", "4"}));
+        unittest::ExpectTrue(!lenient.has_next());
+        unittest::ExpectEqual(std::size_t, diagnostics.size(), 2);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[0].offset, 5);
+        unittest::ExpectTrue(diagnostics[1].error == ParseError::UNTERMINATED_QUOTE);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[1].line, 3);
+
+        // A CR LF inside quotes split between two fragments ends one line
+        diagnostics.clear();
+        CSVPushParser lines(CSVDialect(), rapidcsv::ErrorPolicy::COLLECT, &diagnostics);
+        lines.feed("k,\"\r");
+        lines.feed("\nb\"\r\n2,x\"y\n");
+        lines.finish();
+        unittest::ExpectTrue(lines.next() == VS({"k", "\"\r\nb\""}));
+        unittest::ExpectEqual(std::size_t, diagnostics.size(), 1);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[0].offset, 12);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[0].line, 3);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[0].row, 2);
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
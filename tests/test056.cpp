@@ -0,0 +1,70 @@
+// test056.cpp - event driven reader
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <detail/reader/sax_reader.hpp>
+#include "unittest.h"
+
+// Sums the second column, without keeping any row
+struct SumHandler {
+    double sum = 0;
+    std::size_t fields = 0;
+    std::uint64_t rows = 0;
+
+    void on_field(const rapidcsv::read::FieldView &field, std::size_t column) {
+        ++fields;
+        if (column == 1) {
+            sum += std::stod(field.str());
+        }
+    }
+
+    void on_row_end(std::uint64_t row) {
+        rows = row + 1;
+    }
+};
+
+struct CollectHandler {
+    std::vector<std::vector<std::string>> rows = {{}};
+
+    void on_field(const rapidcsv::read::FieldView &field, std::size_t column) {
+        unittest::ExpectEqual(std::size_t, column, rows.back().size());
+        rows.back().push_back(field.str());
+    }
+
+    void on_row_end(std::uint64_t row) {
+        unittest::ExpectEqual(std::size_t, row + 1, rows.size());
+        rows.emplace_back();
+    }
+};
+
+int main() {
+    int rv = 0;
+
+    using rapidcsv::read::blockReader;
+
+    try {
+        const std::string csv = "a,1.5\nb,2\r\n\"c,d\",3.5\n";
+        SumHandler sum;
+        unittest::ExpectEqual(std::uint64_t, rapidcsv::read::sax_parse(blockReader(csv.data(), csv.data() + csv.size()), sum), 3);
+        unittest::ExpectEqual(double, sum.sum, 7.0);
+        unittest::ExpectEqual(std::size_t, sum.fields, 6);
+        unittest::ExpectEqual(std::uint64_t, sum.rows, 3);
+
+        // Quoted fields are unescaped, a trailing separator ends the last row with an empty field
+        const std::string tsv = "\"x\"\"y\"\tz\n1\t";
+        CollectHandler collect;
+        rapidcsv::read::SaxReader<CollectHandler, rapidcsv::read::FixedDialect<'\t', '"', rapidcsv::RowSepType::LF>>
+                reader(tsv.begin(), tsv.end(), collect, 2);
+        unittest::ExpectEqual(std::uint64_t, reader.run(), 2);
+        unittest::ExpectEqual(std::size_t, collect.rows.size(), 3);
+        unittest::ExpectTrue(collect.rows[0] == std::vector<std::string>({"x\"y", "z"}));
+        unittest::ExpectTrue(collect.rows[1] == std::vector<std::string>({"1", ""}));
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
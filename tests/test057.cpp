@@ -0,0 +1,118 @@
+// test057.cpp - row buffer reuse
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include <detail/reader/row_reader.hpp>
+#include "unittest.h"
+
+#ifndef EXAMPLES_DIR
+#define EXAMPLES_DIR "../examples"
+#endif
+
+// Test hook: counts every heap allocation made by the process. Every form is replaced, so memory
+// always goes back through the matching delete; the frees below pair with the mallocs above
+static std::size_t allocations = 0;
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void *operator new(std::size_t size) {
+    ++allocations;
+    if (void *memory = std::malloc(size > 0 ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+    operator delete(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    operator delete(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept {
+    operator delete(memory);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+int main() {
+    int rv = 0;
+
+    using rapidcsv::read::CSVRowReader;
+    using rapidcsv::read::VS;
+    using rapidcsv::read::blockReader;
+
+    try {
+        std::ifstream file(EXAMPLES_DIR "/msft.csv", std::ios::in | std::ios::binary);
+        unittest::ExpectTrue(file.is_open());
+        CSVRowReader reader(blockReader(file, 4096));
+
+        VS row;
+        reader.next_into(row);
+        unittest::ExpectEqual(std::string, row[0], "Date");
+        unittest::ExpectEqual(std::size_t, row.size(), 7);
+
+        std::size_t rows = 1;
+        const std::size_t before = allocations;
+        while (reader.has_next()) {
+            reader.next_into(row);
+            ++rows;
+        }
+        const std::size_t after = allocations;
+        unittest::ExpectEqual(std::size_t, after, before);
+        unittest::ExpectTrue(rows > 7000);
+        unittest::ExpectEqual(std::size_t, row.size(), 7);
+
+        // Fields too long for the small string buffer keep their capacity from row to row
+        std::string csv;
+        for (int i = 0; i < 100; ++i) {
+            csv += std::string(40, 'a' + i % 26) + ",\"" + std::string(30, 'x') + "\"\"\"\n";
+        }
+        CSVRowReader longReader(blockReader(csv.data(), csv.data() + csv.size()));
+        longReader.next_into(row);
+        unittest::ExpectEqual(std::size_t, row.size(), 2);
+        const std::size_t warm = allocations;
+        while (longReader.has_next()) {
+            longReader.next_into(row);
+        }
+        const std::size_t done = allocations;
+        unittest::ExpectEqual(std::size_t, done, warm);
+        unittest::ExpectEqual(std::string, row[0], std::string(40, 'a' + 99 % 26));
+        unittest::ExpectEqual(std::string, row[1], "\"" + std::string(30, 'x') + "\"\"");
+
+        // Shorter rows shrink the container, longer ones grow it
+        const std::string ragged = "1,2,3\n4\n5,6\n";
+        CSVRowReader raggedReader(blockReader(ragged.data(), ragged.data() + ragged.size()));
+        raggedReader.next_into(row);
+        unittest::ExpectTrue(row == VS({"1", "2", "3"}));
+        raggedReader.next_into(row);
+        unittest::ExpectTrue(row == VS({"4"}));
+        raggedReader.next_into(row);
+        unittest::ExpectTrue(row == VS({"5", "6"}));
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
@@ -0,0 +1,75 @@
+// test058.cpp - arena backed cell storage
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <detail/document/cell_arena.hpp>
+#include "unittest.h"
+
+int main() {
+    int rv = 0;
+
+    using rapidcsv::doc::CellArena;
+    using rapidcsv::doc::CellRef;
+    using rapidcsv::doc::ArenaMesh;
+
+    try {
+        CellArena arena(16);
+        const CellRef a = arena.append(std::string("0123456789"));
+        const CellRef b = arena.append(std::string("abcdef"));
+        unittest::ExpectEqual(std::uint64_t, b.offset, 10);
+        unittest::ExpectEqual(std::size_t, arena.slabs(), 1);
+
+        // Doesn't fit in the rest of the first slab
+        const CellRef c = arena.append(std::string("xyz"));
+        unittest::ExpectEqual(std::uint64_t, c.offset, 16);
+        unittest::ExpectEqual(std::size_t, arena.slabs(), 2);
+
+        // Larger than a slab, gets one of its own
+        const std::string large(40, 'L');
+        const CellRef d = arena.append(large);
+        const CellRef e = arena.append(std::string("e"));
+        unittest::ExpectEqual(std::uint64_t, d.offset, 32);
+        unittest::ExpectEqual(std::uint64_t, e.offset, 80);
+        unittest::ExpectEqual(std::size_t, arena.slabs(), 4);
+
+        const CellRef empty = arena.append(std::string());
+        unittest::ExpectEqual(std::string, arena.str(a), "0123456789");
+        unittest::ExpectEqual(std::string, arena.str(b), "abcdef");
+        unittest::ExpectEqual(std::string, arena.str(c), "xyz");
+        unittest::ExpectEqual(std::string, arena.str(d), large);
+        unittest::ExpectEqual(std::string, arena.str(e), "e");
+        unittest::ExpectTrue(arena.view(empty).empty());
+
+        ArenaMesh mesh(64);
+        mesh.push_back({"Date", "Open", "Close"});
+        mesh.push_back({"2017-02-24", "64.529999"});
+        mesh.push_back({});
+        unittest::ExpectEqual(std::size_t, mesh.size(), 3);
+        unittest::ExpectEqual(std::size_t, mesh.columns(0), 3);
+        unittest::ExpectEqual(std::size_t, mesh[1].size(), 2);
+        unittest::ExpectEqual(std::string, mesh[1][0], "2017-02-24");
+        unittest::ExpectTrue(mesh.cell(0, 2) == rapidcsv::read::FieldView(std::string("Close")));
+        unittest::ExpectTrue(mesh[2].empty());
+        unittest::ExpectTrue(mesh[0].str() == std::vector<std::string>({"Date", "Open", "Close"}));
+        unittest::ExpectEqual(std::size_t, mesh.arena().slabs(), 1);
+
+        bool thrown = false;
+        try {
+            mesh.cell(1, 2);
+        } catch (const std::out_of_range &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+
+        mesh.clear();
+        unittest::ExpectTrue(mesh.empty());
+        unittest::ExpectEqual(std::size_t, mesh.arena().slabs(), 0);
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
@@ -0,0 +1,99 @@
+// test059.cpp - read-ahead block reader
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <detail/reader/prefetch_reader.hpp>
+#include <detail/reader/row_reader.hpp>
+#include "unittest.h"
+
+// Stream buffer that fails after handing out `limit` bytes
+class FailingBuf: public std::stringbuf {
+    std::streamsize _limit;
+
+public:
+    FailingBuf(const std::string &data, std::streamsize limit): std::stringbuf(data), _limit(limit) {}
+
+protected:
+    std::streamsize xsgetn(char *s, std::streamsize count) override {
+        if (_limit <= 0) {
+            throw std::runtime_error("disk gone");
+        }
+        const std::streamsize read = std::stringbuf::xsgetn(s, count < _limit ? count : _limit);
+        _limit -= read;
+        return read;
+    }
+};
+
+int main() {
+    int rv = 0;
+
+    using rapidcsv::read::PrefetchBlockReader;
+
+    try {
+        std::string csv;
+        for (int i = 0; i < 2000; ++i) {
+            csv += std::to_string(i) + ",\"" + std::to_string(i * 7) + "\n\"\n";
+        }
+
+        for (std::size_t buffers : {1, 2, 3, 8}) {
+            for (std::size_t blockSize : {1, 7, 4096}) {
+                std::istringstream stream(csv);
+                PrefetchBlockReader reader(stream.rdbuf(), blockSize, buffers);
+                std::string copy;
+                const char *first, *last;
+                while (reader.next_block(first, last)) {
+                    unittest::ExpectTrue(static_cast<std::size_t>(last - first) <= blockSize);
+                    copy.append(first, last);
+                }
+                unittest::ExpectTrue(copy == csv);
+                unittest::ExpectTrue(!reader.next_block(first, last));
+            }
+        }
+
+        // Parses the same as reading on the parsing thread
+        std::istringstream plain(csv), prefetched(csv);
+        rapidcsv::read::CSVRowReader expected(rapidcsv::read::blockReader(plain, 100));
+        rapidcsv::read::CSVRowReader actual(rapidcsv::read::prefetchBlockReader(prefetched, 100, 4));
+        std::size_t rows = 0;
+        while (expected.has_next()) {
+            unittest::ExpectTrue(actual.has_next());
+            unittest::ExpectTrue(expected.next() == actual.next());
+            ++rows;
+        }
+        unittest::ExpectTrue(!actual.has_next());
+        unittest::ExpectEqual(std::size_t, rows, 2000);
+
+        // Stopping early while the thread is blocked on a full ring
+        {
+            std::istringstream stream(csv);
+            PrefetchBlockReader reader(stream.rdbuf(), 16, 2);
+            const char *first, *last;
+            unittest::ExpectTrue(reader.next_block(first, last));
+        }
+
+        // Read errors come out of next_block after the blocks read before them
+        FailingBuf failing(csv, 100);
+        PrefetchBlockReader reader(&failing, 30, 3);
+        std::size_t bytes = 0;
+        bool thrown = false;
+        try {
+            const char *first, *last;
+            while (reader.next_block(first, last)) {
+                bytes += static_cast<std::size_t>(last - first);
+            }
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+        unittest::ExpectEqual(std::size_t, bytes, 100);
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
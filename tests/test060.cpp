@@ -0,0 +1,94 @@
+// test060.cpp - column projection
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <detail/reader/row_reader.hpp>
+#include <detail/reader/parallel_reader.hpp>
+#include <detail/document/properties.hpp>
+#include "unittest.h"
+
+using rapidcsv::read::VS;
+
+std::vector<VS> readAll(const std::string &csv, const rapidcsv::read::Projection &projection,
+                        rapidcsv::ErrorPolicy policy = rapidcsv::ErrorPolicy::THROW,
+                        rapidcsv::read::Diagnostics *diagnostics = nullptr) {
+    auto reader = rapidcsv::read::rowReader(rapidcsv::read::blockReader(csv.begin(), csv.end(), 7), ',', '"',
+                                            rapidcsv::RowSepType::LF, policy, diagnostics, projection);
+    std::vector<VS> rows;
+    while (reader->has_next()) {
+        rows.push_back(reader->next());
+    }
+    return rows;
+}
+
+int main() {
+    int rv = 0;
+
+    using rapidcsv::read::Projection;
+
+    try {
+        std::ifstream file(EXAMPLES_DIR "/msft.csv", std::ios::binary);
+        const std::string msft((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        unittest::ExpectTrue(!msft.empty());
+
+        // Projecting by name gives the kept columns of the full parse, in input order
+        const auto full = readAll(msft, Projection());
+        const auto byName = readAll(msft, Projection({}, {"Volume", "Close"}));
+        unittest::ExpectEqual(std::size_t, byName.size(), full.size());
+        unittest::ExpectTrue(byName[0] == VS({"Close", "Volume"}));
+        for (std::size_t row = 0; row < full.size(); ++row) {
+            unittest::ExpectTrue(byName[row] == VS({full[row][4], full[row][5]}));
+        }
+
+        // Indices and names together, indices past the last column are ignored
+        unittest::ExpectTrue(readAll(msft, Projection({0, 99}, {"Close"})) == readAll(msft, Projection({0, 4})));
+
+        // Parallel parsing resolves the names up front
+        for (std::size_t threads : {1, 2, 4}) {
+            unittest::ExpectTrue(rapidcsv::read::parallel_parse(msft.data(), msft.data() + msft.size(), ',', '"',
+                                                                rapidcsv::RowSepType::LF, threads, 64,
+                                                                rapidcsv::ErrorPolicy::THROW, nullptr,
+                                                                Projection({}, {"Volume", "Close"})) == byName);
+        }
+
+        // Skipped fields still go through the tokenizer: quoted separators and row separators
+        const std::string quoted = "a,\"b,\n\"\"x\",c\n1,\"2\n,2\",3\n";
+        unittest::ExpectTrue(readAll(quoted, Projection({2})) == std::vector<VS>({{"c"}, {"3"}}));
+        unittest::ExpectTrue(readAll(quoted, Projection({1})) == std::vector<VS>({{"\"b,\n\"x\""}, {"\"2\n,2\""}}));
+
+        // Errors in skipped fields still drop the row, diagnostics give the column in the input
+        rapidcsv::read::Diagnostics diagnostics;
+        const auto rows = readAll("a,b,c\n1,x\"y,3\n4,5,6\n", Projection({0, 2}), rapidcsv::ErrorPolicy::COLLECT,
+                                  &diagnostics);
+        unittest::ExpectTrue(rows == std::vector<VS>({{"a", "c"}, {"4", "6"}}));
+        unittest::ExpectEqual(std::size_t, diagnostics.size(), 1);
+        unittest::ExpectEqual(std::uint32_t, diagnostics[0].column, 2);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[0].line, 2);
+
+        // Unknown names
+        bool thrown = false;
+        try {
+            readAll(msft, Projection({}, {"Closing"}));
+        } catch (const std::out_of_range &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+
+        // Properties
+        const rapidcsv::Properties properties = rapidcsv::PropertiesBuilder().keepColumns({0})
+                .keepColumnNames({"Close", "Volume"});
+        unittest::ExpectTrue(properties.keptColumns() == std::vector<std::size_t>({0}));
+        unittest::ExpectTrue(properties.keptColumnNames() == VS({"Close", "Volume"}));
+        unittest::ExpectTrue(rapidcsv::Properties().keptColumns().empty());
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
@@ -0,0 +1,138 @@
+// test061.cpp - row filter
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <detail/reader/row_reader.hpp>
+#include <detail/reader/parallel_reader.hpp>
+#include <detail/document/properties.hpp>
+#include "unittest.h"
+
+using rapidcsv::read::VS;
+using rapidcsv::read::FieldView;
+using rapidcsv::read::Projection;
+using rapidcsv::read::RowFilter;
+
+std::vector<VS> readAll(const std::string &csv, const RowFilter &filter, const Projection &projection = Projection(),
+                        rapidcsv::ErrorPolicy policy = rapidcsv::ErrorPolicy::THROW,
+                        rapidcsv::read::Diagnostics *diagnostics = nullptr) {
+    auto reader = rapidcsv::read::rowReader(rapidcsv::read::blockReader(csv.begin(), csv.end(), 7), ',', '"',
+                                            rapidcsv::RowSepType::LF, policy, diagnostics, projection, filter);
+    std::vector<VS> rows;
+    while (reader->has_next()) {
+        rows.push_back(reader->next());
+    }
+    return rows;
+}
+
+bool since2017(const FieldView &date) {
+    // Dates only, not the Date header
+    return date.size >= 4 && std::isdigit(static_cast<unsigned char>(date.data[0])) &&
+           std::memcmp(date.data, "2017", 4) >= 0;
+}
+
+int main() {
+    int rv = 0;
+
+    try {
+        std::ifstream file(EXAMPLES_DIR "/msft.csv", std::ios::binary);
+        const std::string msft((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        const auto full = readAll(msft, RowFilter());
+        std::vector<VS> expected(1, full[0]);
+        for (std::size_t row = 1; row < full.size(); ++row) {
+            if (full[row][0] >= "2017") {
+                expected.push_back(full[row]);
+            }
+        }
+        unittest::ExpectTrue(expected.size() > 1 && expected.size() < full.size());
+
+        // Key column by index and by name, the header is never filtered
+        unittest::ExpectTrue(readAll(msft, RowFilter().header(true).key(0, since2017)) == expected);
+        unittest::ExpectTrue(readAll(msft, RowFilter().header(true).key("Date", since2017)) == expected);
+
+        // Without a header the first row is filtered like the others
+        unittest::ExpectTrue(readAll(msft, RowFilter().key(0, since2017)) ==
+                             std::vector<VS>(expected.begin() + 1, expected.end()));
+
+        // Row predicate on the kept fields, after the key
+        const auto volume = [](const std::vector<FieldView> &row) {
+            return row.size() == 2 && row[1].size > 8;
+        };
+        const auto projected = readAll(msft, RowFilter().header(true).key("Date", since2017).rows(volume),
+                                       Projection({}, {"Close", "Volume"}));
+        unittest::ExpectTrue(projected[0] == VS({"Close", "Volume"}));
+        std::size_t count = 1;
+        for (std::size_t row = 1; row < expected.size(); ++row) {
+            if (expected[row][5].size() > 8) {
+                unittest::ExpectTrue(projected[count++] == VS({expected[row][4], expected[row][5]}));
+            }
+        }
+        unittest::ExpectEqual(std::size_t, projected.size(), count);
+
+        // Parallel parsing keeps the same rows
+        for (std::size_t threads : {1, 3}) {
+            unittest::ExpectTrue(rapidcsv::read::parallel_parse(msft.data(), msft.data() + msft.size(), ',', '"',
+                                                                rapidcsv::RowSepType::LF, threads, 64,
+                                                                rapidcsv::ErrorPolicy::THROW, nullptr, Projection(),
+                                                                RowFilter().header(true).key("Date", since2017))
+                                 == expected);
+        }
+
+        // A rejected row is skipped past its quoted row separators, malformed rows are still reported
+        const std::string csv = "k,v\nno,\"a\nb\"\nyes,\"c\nd\"\nyes,x\"y\n";
+        const auto yes = [](const FieldView &key) {
+            return key == FieldView("yes", 3);
+        };
+        rapidcsv::read::Diagnostics diagnostics;
+        unittest::ExpectTrue(readAll(csv, RowFilter().header(true).key(0, yes), Projection(),
+                                     rapidcsv::ErrorPolicy::COLLECT, &diagnostics) ==
+                             std::vector<VS>({{"k", "v"}, {"yes", "\"c\nd\""}}));
+        unittest::ExpectEqual(std::size_t, diagnostics.size(), 1);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[0].line, 6);
+        unittest::ExpectEqual(std::uint64_t, diagnostics[0].row, 4);
+
+        // Unknown key
+        bool thrown = false;
+        try {
+            readAll(msft, RowFilter().header(true).key("Day", since2017));
+        } catch (const std::out_of_range &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+
+        // A key by name needs a header to look it up in, whichever reader
+        thrown = false;
+        try {
+            readAll(msft, RowFilter().key("Date", since2017));
+        } catch (const std::invalid_argument &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+        thrown = false;
+        try {
+            rapidcsv::read::parallel_parse(msft.data(), msft.data() + msft.size(), 4, 4096,
+                                           rapidcsv::read::CSVDialect(), rapidcsv::ErrorPolicy::THROW, nullptr,
+                                           Projection(), RowFilter().key("Date", since2017));
+        } catch (const std::invalid_argument &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+
+        // Properties
+        const rapidcsv::Properties properties = rapidcsv::PropertiesBuilder().filterRows("Date", since2017);
+        unittest::ExpectTrue(!properties.rowFilter().empty() && properties.rowFilter().pending());
+        unittest::ExpectTrue(rapidcsv::Properties().rowFilter().empty());
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
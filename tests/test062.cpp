@@ -0,0 +1,87 @@
+// test062.cpp - row and field statistics
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <detail/reader/row_reader.hpp>
+#include <detail/reader/scan_stats.hpp>
+#include "unittest.h"
+
+using rapidcsv::read::ScanStats;
+using rapidcsv::read::RuntimeDialect;
+
+ScanStats scanInChunks(const std::string &csv, std::size_t chunk, RuntimeDialect dialect = RuntimeDialect()) {
+    rapidcsv::read::StatsScanner scanner(dialect);
+    for (std::size_t at = 0; at < csv.size(); at += chunk) {
+        scanner.feed(csv.data() + at, csv.data() + std::min(csv.size(), at + chunk));
+    }
+    return scanner.finish();
+}
+
+int main() {
+    int rv = 0;
+
+    try {
+        std::ifstream file(EXAMPLES_DIR "/msft.csv", std::ios::binary);
+        const std::string msft((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        std::size_t rows = 0;
+        auto reader = rapidcsv::read::rowReader(rapidcsv::read::blockReader(msft.begin(), msft.end()));
+        while (reader->has_next()) {
+            unittest::ExpectEqual(std::size_t, reader->next().size(), 7);
+            ++rows;
+        }
+
+        const ScanStats stats = rapidcsv::read::scanStats(msft.data(), msft.data() + msft.size());
+        unittest::ExpectEqual(std::uint64_t, stats.rows, rows);
+        unittest::ExpectEqual(std::uint64_t, stats.fields, rows * 7);
+        unittest::ExpectEqual(std::uint64_t, stats.bytes, msft.size());
+        unittest::ExpectEqual(std::size_t, stats.maxFields(), 7);
+        unittest::ExpectEqual(std::uint64_t, stats.fieldCounts[7], rows);
+        unittest::ExpectEqual(std::uint64_t, stats.quotedFields, 0);
+
+        // Quoted separators and row separators, ragged rows, a blank line and a trailing separator
+        const std::string csv = "a,\"b,\r\n\"\"c\"\"\"\r\n\r\n1,2,\"\",4\r\nx,";
+        for (std::size_t chunk : {1, 2, 5, 64}) {
+            const ScanStats ragged = scanInChunks(csv, chunk, RuntimeDialect(',', '"', rapidcsv::RowSepType::CRLF));
+            unittest::ExpectEqual(std::uint64_t, ragged.rows, 4);
+            unittest::ExpectEqual(std::uint64_t, ragged.fields, 9);
+            unittest::ExpectTrue(ragged.fieldCounts == std::vector<std::uint64_t>({0, 1, 2, 0, 1}));
+            unittest::ExpectEqual(std::uint64_t, ragged.quotedFields, 2);
+            unittest::ExpectTrue(ragged.quotedDensity() > 0.22 && ragged.quotedDensity() < 0.23);
+        }
+
+        // CR only rows
+        const ScanStats cr = scanInChunks("a\rb,c\r\r", 1, RuntimeDialect(',', '"', rapidcsv::RowSepType::CR));
+        unittest::ExpectEqual(std::uint64_t, cr.rows, 3);
+        unittest::ExpectTrue(cr.fieldCounts == std::vector<std::uint64_t>({0, 2, 1}));
+
+        // Dialects known at compile time count the same as the run time one
+        const std::string semicolons = "a;\"b;\n\";c\n1;2\r\n\r3";
+        for (rapidcsv::RowSepType rowSep : {rapidcsv::RowSepType::LF, rapidcsv::RowSepType::CRLF,
+                                            rapidcsv::RowSepType::CR}) {
+            const ScanStats fixed = rapidcsv::read::scanStats(semicolons.data(), semicolons.data() + semicolons.size(),
+                                                              ';', '"', rowSep);
+            const ScanStats runtime = scanInChunks(semicolons, 64, RuntimeDialect(';', '"', rowSep));
+            unittest::ExpectEqual(std::uint64_t, fixed.rows, runtime.rows);
+            unittest::ExpectTrue(fixed.fieldCounts == runtime.fieldCounts);
+            unittest::ExpectEqual(std::uint64_t, fixed.quotedFields, runtime.quotedFields);
+        }
+        unittest::ExpectEqual(std::uint64_t, rapidcsv::read::scanStats(semicolons.data(),
+                                                                       semicolons.data() + semicolons.size(), ';',
+                                                                       '"', rapidcsv::RowSepType::LF).rows, 3);
+
+        const ScanStats empty = scanInChunks("", 1);
+        unittest::ExpectEqual(std::uint64_t, empty.rows, 0);
+        unittest::ExpectEqual(std::size_t, empty.maxFields(), 0);
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
@@ -0,0 +1,118 @@
+// test063.cpp - number parsing
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <detail/csv_convert.hpp>
+#include "unittest.h"
+
+using rapidcsv::convert::ConvertError;
+using rapidcsv::convert::ParseResult;
+
+template <typename T>
+ParseResult parse(const std::string &text, T &value) {
+    return rapidcsv::convert::parse_integer(text.data(), text.data() + text.size(), value);
+}
+
+template <typename T>
+ParseResult parseFloat(const std::string &text, T &value) {
+    return rapidcsv::convert::parse_float(text.data(), text.data() + text.size(), value);
+}
+
+template <typename T>
+std::uint64_t bits(T value) {
+    std::uint64_t result = 0;
+    std::memcpy(&result, &value, sizeof(value));
+    return result;
+}
+
+int main() {
+    int rv = 0;
+
+    try {
+        // Integers, with their bounds
+        long long big = 0;
+        unittest::ExpectTrue(parse("-9223372036854775808", big).ok());
+        unittest::ExpectTrue(big == std::numeric_limits<long long>::min());
+        unittest::ExpectTrue(parse("9223372036854775808", big).error == ConvertError::OUT_OF_RANGE);
+        unittest::ExpectTrue(big == std::numeric_limits<long long>::max());
+
+        int small = 0;
+        const std::string bounded = "+2147483647,";
+        ParseResult result = parse(bounded, small);
+        unittest::ExpectTrue(result.ok() && small == 2147483647 && *result.end == ',');
+        unittest::ExpectTrue(parse("-2147483649", small).error == ConvertError::OUT_OF_RANGE);
+        unittest::ExpectEqual(int, small, std::numeric_limits<int>::min());
+
+        unsigned short word = 0;
+        unittest::ExpectTrue(parse("65535", word).ok() && word == 65535);
+        unittest::ExpectTrue(parse("65536", word).error == ConvertError::OUT_OF_RANGE);
+        unittest::ExpectTrue(parse("-1", word).error == ConvertError::OUT_OF_RANGE);
+        unittest::ExpectTrue(parse("-0", word).ok() && word == 0);
+
+        int untouched = 7;
+        const std::string sign = "-";
+        result = parse(sign, untouched);
+        unittest::ExpectTrue(result.error == ConvertError::INVALID && result.end == sign.data() && untouched == 7);
+
+        bool flag = false;
+        unittest::ExpectTrue(parse("1", flag).ok() && flag);
+        unittest::ExpectTrue(parse("2", flag).error == ConvertError::OUT_OF_RANGE);
+
+        // Doubles: the fast path and exactly rounded hard cases
+        double number = 0;
+        unittest::ExpectTrue(parseFloat("64.620003", number).ok() && number == 64.620003);
+        unittest::ExpectTrue(parseFloat("-1.5e3", number).ok() && number == -1500.0);
+        unittest::ExpectTrue(parseFloat(".5", number).ok() && number == 0.5);
+        unittest::ExpectTrue(parseFloat("9007199254740993", number).ok() && number == 9007199254740992.0);
+        unittest::ExpectTrue(parseFloat("2.2250738585072011e-308", number).ok() &&
+                             bits(number) == 0x000FFFFFFFFFFFFFull);
+        unittest::ExpectTrue(parseFloat("4.9406564584124654e-324", number).ok() && bits(number) == 1);
+        unittest::ExpectTrue(parseFloat("2.4703282292062327e-324", number).ok() && number == 0.0);
+        unittest::ExpectTrue(parseFloat("2.4703282292062328e-324", number).ok() && bits(number) == 1);
+        unittest::ExpectTrue(parseFloat("1.7976931348623157e308", number).ok() &&
+                             number == std::numeric_limits<double>::max());
+        unittest::ExpectTrue(parseFloat("1.7976931348623159e308", number).error == ConvertError::OUT_OF_RANGE &&
+                             std::isinf(number));
+        unittest::ExpectTrue(parseFloat("123456789012345678901234567890", number).ok() &&
+                             number == 123456789012345678901234567890.0);
+        unittest::ExpectTrue(parseFloat("1e-400", number).ok() && number == 0.0);
+        unittest::ExpectTrue(parseFloat("-0", number).ok() && number == 0.0 && std::signbit(number));
+        unittest::ExpectTrue(parseFloat("-Infinity", number).ok() && std::isinf(number) && number < 0);
+        unittest::ExpectTrue(parseFloat("nan", number).ok() && std::isnan(number));
+
+        // An exponent without digits is not part of the number
+        const std::string dangling = "5e+";
+        result = parseFloat(dangling, number);
+        unittest::ExpectTrue(result.ok() && number == 5.0 && result.end == dangling.data() + 1);
+        unittest::ExpectTrue(parseFloat(".", number).error == ConvertError::INVALID);
+        unittest::ExpectTrue(parseFloat("e5", number).error == ConvertError::INVALID);
+
+        // Floats are rounded once, from the decimal
+        float single = 0;
+        unittest::ExpectTrue(parseFloat("1.00000005960464477550", single).ok() && single == 1.00000012f);
+        unittest::ExpectTrue(parseFloat("3.4028235e38", single).ok() && single == std::numeric_limits<float>::max());
+        unittest::ExpectTrue(parseFloat("3.4028236e38", single).error == ConvertError::OUT_OF_RANGE);
+        unittest::ExpectTrue(parseFloat("1.4e-45", single).ok() && bits(single) == 1);
+
+        // convert_to_val dispatches on the type, like a stream it skips leading whitespace
+        unittest::ExpectEqual(int, rapidcsv::convert::convert_to_val<int>(" 42"), 42);
+        unittest::ExpectEqual(int, rapidcsv::convert::convert_to_val<int>("abc"), 0);
+        unittest::ExpectTrue(rapidcsv::convert::convert_to_val<double>("64.620003") == 64.620003);
+        unittest::ExpectTrue(rapidcsv::convert::convert_to_val<float>("21705200") == 21705200.0f);
+        unittest::ExpectTrue(rapidcsv::convert::convert_to_val<unsigned long>("18446744073709551615") ==
+                             18446744073709551615ul);
+        unittest::ExpectTrue(rapidcsv::convert::convert_to_val<char>(" x") == 'x');
+        unittest::ExpectTrue(rapidcsv::convert::convert_to_val<long double>("0.25") == 0.25L);
+        unittest::ExpectTrue(rapidcsv::convert::convert_to_val<std::string>(" a ") == " a ");
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
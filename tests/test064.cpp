@@ -0,0 +1,142 @@
+// test064.cpp - number formatting
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <detail/csv_convert.hpp>
+#include "unittest.h"
+
+using rapidcsv::convert::convert_to_string;
+
+template <typename T>
+std::string format(T value) {
+    char buffer[rapidcsv::convert::maxNumberLength];
+    return std::string(buffer, rapidcsv::convert::to_chars(buffer, value));
+}
+
+// Formats and parses back a value, true when the bits are unchanged
+template <typename T, typename Bits>
+bool roundTrips(Bits bits) {
+    T value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (std::isnan(value)) {
+        return true;
+    }
+    const std::string text = format(value);
+    T back = 0;
+    rapidcsv::convert::parse_float(text.data(), text.data() + text.size(), back);
+    return std::memcmp(&back, &value, sizeof(value)) == 0;
+}
+
+// Significant digits of a number as printed, without leading nor trailing zeros
+std::string significand(const std::string &text) {
+    std::string digits;
+    for (std::size_t at = 0; at < text.size() && text[at] != 'e'; ++at) {
+        if (text[at] >= '0' && text[at] <= '9' && (!digits.empty() || text[at] != '0')) {
+            digits += text[at];
+        }
+    }
+    while (digits.size() > 1 && digits.back() == '0') {
+        digits.pop_back();
+    }
+    return digits;
+}
+
+// Reference: the correctly rounded digits at the lowest precision that printf and strtod read back
+template <typename T>
+std::string shortestReference(T value) {
+    char text[64];
+    for (int precision = 1; ; ++precision) {
+        std::snprintf(text, sizeof(text), "%.*e", precision - 1, static_cast<double>(value));
+        const T back = std::is_same<T, float>::value ? static_cast<T>(std::strtof(text, nullptr))
+                                                     : static_cast<T>(std::strtod(text, nullptr));
+        if (back == value) {
+            return significand(text);
+        }
+    }
+}
+
+// The digits written are the reference ones, or fewer: next to a power of two the reference can miss
+// shorter digits above the value
+template <typename T, typename Bits>
+bool shortest(Bits bits) {
+    T value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (!std::isfinite(value) || value == 0) {
+        return true;
+    }
+    const std::string digits = significand(format(value)), reference = shortestReference(value);
+    return digits == reference || digits.size() < reference.size();
+}
+
+int main() {
+    int rv = 0;
+
+    try {
+        // Integers, with their bounds
+        unittest::ExpectEqual(std::string, format(0), "0");
+        unittest::ExpectEqual(std::string, format(-7), "-7");
+        unittest::ExpectEqual(std::string, format(1234567890), "1234567890");
+        unittest::ExpectEqual(std::string, format(std::numeric_limits<long long>::min()), "-9223372036854775808");
+        unittest::ExpectEqual(std::string, format(std::numeric_limits<unsigned long long>::max()),
+                              "18446744073709551615");
+        unittest::ExpectEqual(std::string, format(static_cast<short>(-32768)), "-32768");
+
+        // Shortest digits, plain notation for moderate exponents
+        unittest::ExpectEqual(std::string, format(0.1), "0.1");
+        unittest::ExpectEqual(std::string, format(0.1 + 0.2), "0.30000000000000004");
+        unittest::ExpectEqual(std::string, format(64.620003), "64.620003");
+        unittest::ExpectEqual(std::string, format(-1500.0), "-1500");
+        unittest::ExpectEqual(std::string, format(0.000001), "0.000001");
+        unittest::ExpectEqual(std::string, format(1e-7), "1e-07");
+        unittest::ExpectEqual(std::string, format(1e21), "1e+21");
+        unittest::ExpectEqual(std::string, format(123456789012345680000.0), "123456789012345680000");
+        unittest::ExpectEqual(std::string, format(5e-324), "5e-324");
+        unittest::ExpectEqual(std::string, format(std::numeric_limits<double>::max()), "1.7976931348623157e+308");
+        unittest::ExpectEqual(std::string, format(-0.0), "-0");
+        unittest::ExpectEqual(std::string, format(-std::numeric_limits<double>::infinity()), "-inf");
+        unittest::ExpectEqual(std::string, format(std::numeric_limits<double>::quiet_NaN()), "nan");
+
+        // Floats get the digits of a float, not of the double it widens to
+        unittest::ExpectEqual(std::string, format(0.3f), "0.3");
+        unittest::ExpectEqual(std::string, format(21705200.0f), "21705200");
+        unittest::ExpectEqual(std::string, format(std::numeric_limits<float>::denorm_min()), "1e-45");
+
+        // Values Grisu2 alone gives a digit too many for
+        unittest::ExpectEqual(std::string, format(8481620698703041000.0), "8481620698703040000");
+        unittest::ExpectEqual(std::string, format(4.1752050594835e+78), "4.1752050594835e+78");
+        unittest::ExpectEqual(std::string, format(31322315702267410.0), "31322315702267410");
+        unittest::ExpectEqual(std::string, format(3.15723672252789e-156), "3.15723672252789e-156");
+        unittest::ExpectEqual(std::string, format(1e23), "1e+23");
+
+        std::mt19937_64 random(64);
+        for (int i = 0; i < 100000; ++i) {
+            const std::uint64_t bits = random();
+            unittest::ExpectTrue(roundTrips<double>(bits));
+            unittest::ExpectTrue(roundTrips<float>(static_cast<std::uint32_t>(bits)));
+            unittest::ExpectTrue(shortest<double>(bits));
+            unittest::ExpectTrue(shortest<float>(static_cast<std::uint32_t>(bits)));
+        }
+
+        // convert_to_string dispatches on the type
+        unittest::ExpectEqual(std::string, convert_to_string(42), "42");
+        unittest::ExpectEqual(std::string, convert_to_string(2.5), "2.5");
+        unittest::ExpectEqual(std::string, convert_to_string(true), "1");
+        unittest::ExpectEqual(std::string, convert_to_string('x'), "x");
+        unittest::ExpectEqual(std::string, convert_to_string(0.25L), "0.25");
+        unittest::ExpectEqual(std::string, convert_to_string(std::string("a b")), "a b");
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
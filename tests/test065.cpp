@@ -0,0 +1,88 @@
+// test065.cpp - whole column conversion
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include <detail/csv_convert.hpp>
+#include <detail/convert/column_converter.hpp>
+#include <detail/document/cell_arena.hpp>
+#include "unittest.h"
+
+using rapidcsv::convert::FailureBitmap;
+using rapidcsv::read::FieldView;
+
+std::vector<FieldView> views(const std::vector<std::string> &cells) {
+    std::vector<FieldView> result;
+    for (const auto &cell : cells) {
+        result.emplace_back(cell);
+    }
+    return result;
+}
+
+int main() {
+    int rv = 0;
+
+    try {
+        // Integers, eight digits at a time and one by one
+        const std::vector<std::string> volumes = {"61367100", "1234567890123456789", "-42", "+7", "0", "",
+                                                  "12a", " 15 ", "9223372036854775808", "-9223372036854775808",
+                                                  "1e3", "00000000000000000000000000001"};
+        FailureBitmap failures;
+        const std::vector<long long> numbers = rapidcsv::convert::convert_column<long long>(views(volumes), failures);
+        unittest::ExpectEqual(std::size_t, numbers.size(), volumes.size());
+        unittest::ExpectEqual(std::size_t, failures.size(), volumes.size());
+        unittest::ExpectTrue(numbers[0] == 61367100 && numbers[1] == 1234567890123456789LL);
+        unittest::ExpectTrue(numbers[2] == -42 && numbers[3] == 7 && numbers[4] == 0);
+        unittest::ExpectTrue(numbers[7] == 15 && numbers[9] == std::numeric_limits<long long>::min());
+        unittest::ExpectTrue(numbers[11] == 1);
+        for (std::size_t cell : {5, 6, 8, 10}) {
+            unittest::ExpectTrue(failures.test(cell));
+        }
+        unittest::ExpectEqual(std::size_t, failures.count(), 4);
+
+        // Failed cells hold what convert_to_val gives
+        for (std::size_t cell = 0; cell < volumes.size(); ++cell) {
+            unittest::ExpectTrue(numbers[cell] == rapidcsv::convert::convert_to_val<long long>(volumes[cell]));
+        }
+
+        // Out of range for the type
+        const std::vector<unsigned short> words = rapidcsv::convert::convert_column<unsigned short>(
+                views({"65535", "65536", "-1", "-0"}), failures);
+        unittest::ExpectTrue(words[0] == 65535 && words[1] == 65535 && words[3] == 0);
+        unittest::ExpectTrue(!failures.test(0) && failures.test(1) && failures.test(2) && !failures.test(3));
+
+        // Decimals, exactly rounded whether or not they take the fast path
+        const std::vector<std::string> closes = {"64.620003", "-0.5", "123456789.123456789", "5.", ".25",
+                                                 "1e-3", "nan", "-", "1.2.3", "0.1000000000000000055511151231257827"};
+        const std::vector<double> prices = rapidcsv::convert::convert_column<double>(views(closes), failures);
+        unittest::ExpectTrue(prices[0] == 64.620003 && prices[1] == -0.5 && prices[2] == 123456789.123456789);
+        unittest::ExpectTrue(prices[3] == 5.0 && prices[4] == 0.25 && prices[5] == 0.001 && std::isnan(prices[6]));
+        unittest::ExpectTrue(prices[9] == 0.1);
+        unittest::ExpectTrue(failures.test(7) && failures.test(8) && failures.count() == 2);
+
+        const std::vector<float> singles = rapidcsv::convert::convert_column<float>(views(closes), failures);
+        for (std::size_t cell = 0; cell < 6; ++cell) {
+            unittest::ExpectTrue(singles[cell] == rapidcsv::convert::convert_to_val<float>(closes[cell]));
+        }
+
+        // Straight from the cells of an arena
+        rapidcsv::doc::ArenaMesh mesh;
+        mesh.push_back({"Date", "Close", "Volume"});
+        mesh.push_back({"2017-02-24", "64.620003", "21705200"});
+        mesh.push_back({"2017-02-23"});
+        mesh.push_back({"2017-02-22", "64.360001", "19259700"});
+        const std::vector<FieldView> column = mesh.column(2, 1);
+        unittest::ExpectEqual(std::size_t, column.size(), 2);
+        const std::vector<int> volume = rapidcsv::convert::convert_column<int>(column, failures);
+        unittest::ExpectTrue(volume == std::vector<int>({21705200, 19259700}) && !failures.any());
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
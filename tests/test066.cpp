@@ -0,0 +1,140 @@
+// test066.cpp - schema inference and numeric columns
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <detail/reader/row_reader.hpp>
+#include <detail/document/schema.hpp>
+#include <detail/document/typed_column.hpp>
+#include "unittest.h"
+
+using rapidcsv::doc::ColumnType;
+using rapidcsv::doc::TypeInferrer;
+using rapidcsv::doc::TypedColumn;
+using rapidcsv::read::FieldView;
+
+ColumnType infer(const std::vector<std::string> &cells) {
+    TypeInferrer inferrer;
+    for (const auto &cell : cells) {
+        inferrer.add(FieldView(cell));
+    }
+    return inferrer.type();
+}
+
+std::vector<FieldView> views(const std::vector<std::string> &cells) {
+    std::vector<FieldView> result;
+    for (const auto &cell : cells) {
+        result.emplace_back(cell);
+    }
+    return result;
+}
+
+int main() {
+    int rv = 0;
+
+    try {
+        // One type per column of the example file
+        std::ifstream file(EXAMPLES_DIR "/msft.csv", std::ios::binary);
+        const std::string msft((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        auto reader = rapidcsv::read::rowReader(rapidcsv::read::blockReader(msft.begin(), msft.end()));
+        const std::vector<std::string> header = reader->next();
+        std::vector<std::vector<std::string>> columns(header.size());
+        while (reader->has_next()) {
+            const std::vector<std::string> row = reader->next();
+            for (std::size_t column = 0; column < row.size(); ++column) {
+                columns[column].push_back(row[column]);
+            }
+        }
+
+        rapidcsv::doc::Schema schema;
+        for (std::size_t column = 0; column < header.size(); ++column) {
+            schema.add(header[column], infer(columns[column]));
+        }
+        unittest::ExpectTrue(schema.type("Date") == ColumnType::DATE);
+        // Older prices are written like 64.00, a number all the same
+        unittest::ExpectTrue(schema.type("Close") == ColumnType::DOUBLE);
+        unittest::ExpectTrue(schema.type("Volume") == ColumnType::INT64);
+        unittest::ExpectEqual(std::string, schema.name(6), "Adj Close");
+
+        // Unknown columns
+        bool thrown = false;
+        try {
+            schema.type("Price");
+        } catch (const std::out_of_range &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+
+        // Mixed and ambiguous cells
+        unittest::ExpectTrue(infer({"1", "", "-2"}) == ColumnType::INT64);
+        unittest::ExpectTrue(infer({"1", "2.5"}) == ColumnType::DOUBLE);
+        unittest::ExpectTrue(infer({"TRUE", "false"}) == ColumnType::BOOL);
+        unittest::ExpectTrue(infer({"1", "true"}) == ColumnType::STRING);
+        unittest::ExpectTrue(infer({"02134", "10001"}) == ColumnType::INT64);
+        unittest::ExpectTrue(infer({"nan", "1.5"}) == ColumnType::STRING);
+        unittest::ExpectTrue(infer({"0.5", "-0.25", "0"}) == ColumnType::DOUBLE);
+        unittest::ExpectTrue(infer({"2017-02-24", "2017-13-01"}) == ColumnType::STRING);
+        unittest::ExpectTrue(infer({"", ""}) == ColumnType::STRING);
+        unittest::ExpectTrue(infer({" 1"}) == ColumnType::STRING);
+
+        // Volumes held as numbers print back as they were read
+        TypedColumn volume(ColumnType::INT64);
+        unittest::ExpectTrue(volume.assign(views(columns[5])));
+        unittest::ExpectEqual(std::size_t, volume.size(), columns[5].size());
+        unittest::ExpectEqual(std::string, volume.str(0), "21705200");
+        const std::vector<std::int64_t> volumes = volume.values<std::int64_t>();
+        unittest::ExpectEqual(std::int64_t, volumes[1], 20235200);
+        unittest::ExpectTrue(volume.values<double>()[1] == 20235200.0);
+        unittest::ExpectTrue(volume.memory() < columns[5].size() * sizeof(std::string));
+
+        // Leading zeros, trailing zeros, exponents and digits a double can't hold are numbers too, their
+        // text is kept on the side so that they print back as they were read
+        TypedColumn codes(ColumnType::INT64);
+        unittest::ExpectTrue(codes.assign(views({"12", "007", "+5"})));
+        unittest::ExpectTrue(codes.values<std::int64_t>() == std::vector<std::int64_t>({12, 7, 5}));
+        unittest::ExpectEqual(std::string, codes.str(0), "12");
+        unittest::ExpectEqual(std::string, codes.str(1), "007");
+        unittest::ExpectEqual(std::string, codes.str(2), "+5");
+        unittest::ExpectEqual(std::size_t, codes.texts(), 2);
+        for (const char *cell : {"1.50", "1e3", "00.5", "9007199254740993", "12345678901234567890", "+1.5"}) {
+            TypedColumn prices(ColumnType::DOUBLE);
+            unittest::ExpectTrue(prices.assign(views({"1.5", cell})));
+            unittest::ExpectEqual(std::string, prices.str(1), cell);
+            unittest::ExpectEqual(std::size_t, prices.texts(), 1);
+        }
+        unittest::ExpectTrue(!TypedColumn(ColumnType::INT64).assign(views({"1", "12345678901234567890"})));
+        unittest::ExpectTrue(infer({"1.5", "1.50"}) == ColumnType::DOUBLE);
+        unittest::ExpectTrue(infer({"1.5", "9007199254740993"}) == ColumnType::DOUBLE);
+        unittest::ExpectTrue(infer({"9007199254740993"}) == ColumnType::INT64);
+
+        TypedColumn close(ColumnType::DOUBLE);
+        unittest::ExpectTrue(close.assign(views({"64.620003", "", "1.5"})));
+        unittest::ExpectTrue(close.empty(1) && !close.empty(0));
+        unittest::ExpectEqual(std::string, close.str(1), "");
+        unittest::ExpectEqual(std::string, close.str(2), "1.5");
+        unittest::ExpectTrue(close.values<double>()[0] == 64.620003);
+
+        // Only the type the cells are held as gets a plain copy
+        unittest::ExpectTrue(close.stored_as<double>() && !close.stored_as<float>() && !close.stored_as<int>());
+        unittest::ExpectTrue(volume.stored_as<std::int64_t>() && volume.stored_as<long long>());
+        unittest::ExpectTrue(!volume.stored_as<std::uint64_t>() && !volume.stored_as<std::uint8_t>());
+        unittest::ExpectTrue(!volume.stored_as<double>());
+
+        // Edits that fit the column are kept as numbers, the others are refused
+        unittest::ExpectTrue(close.set(1, "2.25") && !close.empty(1) && close.str(1) == "2.25");
+        unittest::ExpectTrue(close.set(0, "") && close.empty(0));
+        unittest::ExpectTrue(!close.set(2, "n/a") && close.str(2) == "1.5");
+        unittest::ExpectTrue(close.set(2, "2.50") && close.str(2) == "2.50" && close.values<double>()[2] == 2.5);
+        unittest::ExpectTrue(close.set(2, "2.5") && close.str(2) == "2.5" && close.texts() == 0);
+        unittest::ExpectTrue(!TypedColumn(ColumnType::DOUBLE).assign(views({"1", "x"})));
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
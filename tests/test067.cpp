@@ -0,0 +1,130 @@
+// test067.cpp - date and timestamp conversion
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <detail/csv_convert.hpp>
+#include <detail/convert/column_converter.hpp>
+#include <detail/document/typed_column.hpp>
+#include <detail/reader/row_reader.hpp>
+#include "unittest.h"
+
+using rapidcsv::convert::Date;
+using rapidcsv::convert::DateFormat;
+using rapidcsv::convert::FormattedDate;
+using rapidcsv::convert::Timestamp;
+
+template <DateFormat F>
+bool parses(const std::string &text, std::int64_t days) {
+    FormattedDate<F> date;
+    const rapidcsv::convert::ParseResult result = rapidcsv::convert::parse_date(text.data(), text.data() + text.size(), date);
+    return result.ok() && result.end == text.data() + text.size() && date.days == days;
+}
+
+template <DateFormat F>
+bool rejects(const std::string &text) {
+    FormattedDate<F> date(7);
+    return !rapidcsv::convert::parse_date(text.data(), text.data() + text.size(), date).ok() && date.days == 7;
+}
+
+std::int64_t seconds(const std::string &text) {
+    Timestamp timestamp(-1);
+    const rapidcsv::convert::ParseResult result =
+            rapidcsv::convert::parse_timestamp(text.data(), text.data() + text.size(), timestamp);
+    return result.ok() && result.end == text.data() + text.size() ? timestamp.seconds : -1;
+}
+
+int main() {
+    int rv = 0;
+
+    try {
+        // Every layout, 2017-02-24 is day 17221
+        unittest::ExpectTrue(parses<DateFormat::ISO>("1970-01-01", 0));
+        unittest::ExpectTrue(parses<DateFormat::ISO>("2017-02-24", 17221));
+        unittest::ExpectTrue(parses<DateFormat::COMPACT>("20170224", 17221));
+        unittest::ExpectTrue(parses<DateFormat::US>("02/24/2017", 17221));
+        unittest::ExpectTrue(parses<DateFormat::EUROPEAN>("24.02.2017", 17221));
+        unittest::ExpectTrue(parses<DateFormat::EUROPEAN>("24/02/2017", 17221));
+        unittest::ExpectTrue(parses<DateFormat::ISO>("1969-12-31", -1));
+        unittest::ExpectTrue(parses<DateFormat::ISO>("0000-03-01", -719468));
+
+        // Days checked against the month, leap years included
+        unittest::ExpectTrue(parses<DateFormat::ISO>("2000-02-29", 11016));
+        unittest::ExpectTrue(rejects<DateFormat::ISO>("1900-02-29"));
+        unittest::ExpectTrue(rejects<DateFormat::ISO>("2017-04-31"));
+        unittest::ExpectTrue(rejects<DateFormat::ISO>("2017-13-01"));
+        unittest::ExpectTrue(rejects<DateFormat::ISO>("2017-00-10"));
+        unittest::ExpectTrue(rejects<DateFormat::ISO>("2017/02/24"));
+        unittest::ExpectTrue(rejects<DateFormat::ISO>("2017-2-24"));
+        unittest::ExpectTrue(rejects<DateFormat::US>("02/24-2017"));
+        unittest::ExpectTrue(rejects<DateFormat::COMPACT>("2017022"));
+
+        // Every day of four centuries reads back what it writes
+        for (std::int64_t days = -146097; days < 2 * 146097; ++days) {
+            char buffer[rapidcsv::convert::maxNumberLength];
+            const Date date(days);
+            const std::string text(buffer, rapidcsv::convert::to_chars(buffer, date));
+            Date back;
+            rapidcsv::convert::parse_date(text.data(), text.data() + text.size(), back);
+            unittest::ExpectTrue(back == date);
+        }
+
+        // Timestamps, with and without time, seconds, fractions and offsets
+        unittest::ExpectEqual(std::int64_t, seconds("2017-02-24"), 17221 * 86400LL);
+        unittest::ExpectEqual(std::int64_t, seconds("2017-02-24T09:30"), 17221 * 86400LL + 34200);
+        unittest::ExpectEqual(std::int64_t, seconds("2017-02-24 09:30:15"), 17221 * 86400LL + 34215);
+        unittest::ExpectEqual(std::int64_t, seconds("2017-02-24T09:30:15.123456Z"), 17221 * 86400LL + 34215);
+        unittest::ExpectEqual(std::int64_t, seconds("2017-02-24T09:30:15+02:00"), 17221 * 86400LL + 27015);
+        unittest::ExpectEqual(std::int64_t, seconds("2017-02-24T09:30:15-0530"), 17221 * 86400LL + 54015);
+        unittest::ExpectEqual(std::int64_t, seconds("2017-02-24T09:30:15+01"), 17221 * 86400LL + 30615);
+        unittest::ExpectEqual(std::int64_t, seconds("2017-02-24T24:00:00"), -1);
+        unittest::ExpectEqual(std::int64_t, seconds("2017-02-24T09:60"), -1);
+
+        // Conversions by type
+        unittest::ExpectTrue(rapidcsv::convert::convert_to_val<Date>(" 2017-02-24") == Date(17221));
+        unittest::ExpectTrue(rapidcsv::convert::convert_to_val<Date>("24.02.2017") == Date(0));
+        unittest::ExpectTrue(rapidcsv::convert::convert_to_val<FormattedDate<DateFormat::EUROPEAN>>("24.02.2017").days ==
+                             17221);
+        unittest::ExpectTrue(rapidcsv::convert::convert_to_val<Timestamp>("1970-01-02T00:00:01Z") == Timestamp(86401));
+        unittest::ExpectEqual(std::string, rapidcsv::convert::convert_to_string(Date(17221)), "2017-02-24");
+        unittest::ExpectEqual(std::string, rapidcsv::convert::convert_to_string(FormattedDate<DateFormat::US>(17221)),
+                              "02/24/2017");
+        unittest::ExpectEqual(std::string, rapidcsv::convert::convert_to_string(FormattedDate<DateFormat::COMPACT>(-1)),
+                              "19691231");
+        unittest::ExpectEqual(std::string, rapidcsv::convert::convert_to_string(Timestamp(-1)), "1969-12-31T23:59:59Z");
+
+        // The Date column of the example file, in one batch
+        std::ifstream file(EXAMPLES_DIR "/msft.csv", std::ios::binary);
+        const std::string msft((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        auto reader = rapidcsv::read::rowReader(rapidcsv::read::blockReader(msft.begin(), msft.end()));
+        reader->next();
+        std::vector<std::string> cells;
+        while (reader->has_next()) {
+            cells.push_back(reader->next()[0]);
+        }
+        std::vector<rapidcsv::read::FieldView> views;
+        for (const auto &cell : cells) {
+            views.emplace_back(cell);
+        }
+        rapidcsv::convert::FailureBitmap failures;
+        const std::vector<Date> dates = rapidcsv::convert::convert_column<Date>(views, failures);
+        unittest::ExpectTrue(!failures.any() && dates[0] == Date(17221) && dates[1] == Date(17220));
+
+        // Held as day numbers, printed back as read
+        rapidcsv::doc::TypedColumn column(rapidcsv::doc::ColumnType::DATE);
+        unittest::ExpectTrue(column.assign(views));
+        unittest::ExpectEqual(std::string, column.str(0), cells[0]);
+        unittest::ExpectTrue(column.values<Date>() == dates);
+        unittest::ExpectTrue(!column.set(0, "2017-02-30") && column.set(1, "2017-03-01"));
+        unittest::ExpectEqual(std::string, column.str(1), "2017-03-01");
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
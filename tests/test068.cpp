@@ -0,0 +1,180 @@
+// test068.cpp - dense row storage
+
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <detail/reader/row_reader.hpp>
+#include <detail/document/dense_mesh.hpp>
+#include "unittest.h"
+
+using rapidcsv::doc::DenseMesh;
+using rapidcsv::read::FieldView;
+
+int main() {
+    int rv = 0;
+
+    try {
+        // Ragged rows keep their own length
+        DenseMesh mesh;
+        unittest::ExpectTrue(mesh.empty());
+        mesh.push_back({"Date", "Close", "Volume"});
+        mesh.push_back({"2017-02-24", "64.620003", "21705200"});
+        mesh.push_back({"2017-02-23"});
+        mesh.push_back({});
+        mesh.push_back({"2017-02-22", "64.360001", "19259700", "extra"});
+        unittest::ExpectEqual(std::size_t, mesh.size(), 5);
+        unittest::ExpectEqual(std::size_t, mesh.columns(0), 3);
+        unittest::ExpectEqual(std::size_t, mesh.columns(2), 1);
+        unittest::ExpectEqual(std::size_t, mesh.columns(3), 0);
+        unittest::ExpectEqual(std::size_t, mesh.columns(4), 4);
+        unittest::ExpectEqual(std::string, mesh.str(1, 1), "64.620003");
+        unittest::ExpectEqual(std::string, mesh.str(4, 3), "extra");
+        unittest::ExpectTrue(mesh.has(1, 2) && !mesh.has(2, 1) && !mesh.has(3, 0));
+        unittest::ExpectEqual(std::string, mesh.str(2, 2), "");
+
+        // Rows without the column are skipped
+        const std::vector<FieldView> volumes = mesh.column(2, 1);
+        unittest::ExpectEqual(std::size_t, volumes.size(), 2);
+        unittest::ExpectEqual(std::string, volumes[0].str(), "21705200");
+        unittest::ExpectEqual(std::string, volumes[1].str(), "19259700");
+
+        // Shorter values are written in place, longer ones appended
+        mesh.set(1, 1, "64.6");
+        unittest::ExpectEqual(std::string, mesh.str(1, 1), "64.6");
+        unittest::ExpectEqual(std::size_t, mesh.garbage(), 5);
+        mesh.set(1, 1, "1064.620003");
+        unittest::ExpectEqual(std::string, mesh.str(1, 1), "1064.620003");
+        unittest::ExpectEqual(std::size_t, mesh.garbage(), 9);
+
+        // Setting past the end of a row grows it, the rows after it stay where they are
+        mesh.set(2, 2, "19000000");
+        unittest::ExpectEqual(std::size_t, mesh.columns(2), 3);
+        unittest::ExpectTrue(!mesh.has(2, 1) && mesh.has(2, 2));
+        unittest::ExpectEqual(std::string, mesh.str(2, 2), "19000000");
+        unittest::ExpectEqual(std::string, mesh.str(4, 0), "2017-02-22");
+        unittest::ExpectEqual(std::size_t, mesh.column(2, 1).size(), 3);
+
+        // Erased cells keep their slot
+        mesh.erase(4, 1);
+        unittest::ExpectTrue(!mesh.has(4, 1) && mesh.has(4, 2));
+        unittest::ExpectEqual(std::size_t, mesh.columns(4), 4);
+        unittest::ExpectEqual(std::string, mesh.str(4, 2), "19259700");
+        const std::vector<std::string> row = mesh.row(4);
+        unittest::ExpectTrue(row == std::vector<std::string>({"2017-02-22", "", "19259700", "extra"}));
+
+        // Whole rows
+        mesh.set_row(3, {"2017-02-21", "64.489998"});
+        unittest::ExpectEqual(std::size_t, mesh.columns(3), 2);
+        unittest::ExpectEqual(std::string, mesh.str(3, 1), "64.489998");
+        unittest::ExpectEqual(std::string, mesh.str(4, 3), "extra");
+        mesh.erase_row(2);
+        unittest::ExpectEqual(std::size_t, mesh.size(), 4);
+        unittest::ExpectEqual(std::string, mesh.str(2, 0), "2017-02-21");
+        unittest::ExpectEqual(std::string, mesh.str(3, 2), "19259700");
+
+        // A whole column below the header, the short rows grow and the others keep their cells
+        mesh.set_column(4, {"a", "b", "c"}, 1);
+        unittest::ExpectEqual(std::size_t, mesh.columns(0), 3);
+        unittest::ExpectTrue(mesh.row(1) == std::vector<std::string>({"2017-02-24", "1064.620003", "21705200", "", "a"}));
+        unittest::ExpectTrue(mesh.row(2) == std::vector<std::string>({"2017-02-21", "64.489998", "", "", "b"}));
+        unittest::ExpectTrue(mesh.row(3) == std::vector<std::string>({"2017-02-22", "", "19259700", "extra", "c"}));
+        unittest::ExpectTrue(!mesh.has(1, 3) && !mesh.has(2, 2) && mesh.has(3, 3));
+        mesh.set_column(0, {"2017-02-20"}, 2);
+        unittest::ExpectEqual(std::string, mesh.str(2, 0), "2017-02-20");
+        unittest::ExpectEqual(std::string, mesh.str(3, 0), "2017-02-22");
+
+        // Compacting drops the unreferenced bytes and keeps every cell
+        std::vector<std::vector<std::string>> before;
+        for (std::size_t index = 0; index < mesh.size(); ++index) {
+            before.push_back(mesh.row(index));
+        }
+        mesh.compact();
+        unittest::ExpectEqual(std::size_t, mesh.garbage(), 0);
+        for (std::size_t index = 0; index < mesh.size(); ++index) {
+            unittest::ExpectTrue(mesh.row(index) == before[index]);
+        }
+
+        // Cells found byte for byte in the source refer to it, the others are copied. Edits never write to it
+        const std::string source = "a,\"b \"\"c\"\"\",d";
+        DenseMesh sourced;
+        sourced.source(source.data(), source.size());
+        sourced.push_back({"a", "\"b \"c\"\"", "d"}, {0, 2, 12});
+        unittest::ExpectTrue(sourced.cell(0, 0).data == source.data());
+        unittest::ExpectTrue(sourced.cell(0, 2).data == source.data() + 12);
+        unittest::ExpectEqual(std::string, sourced.str(0, 1), "\"b \"c\"\"");
+        unittest::ExpectEqual(std::size_t, sourced.slabs(), 1);
+        sourced.set(0, 2, "e");
+        sourced.erase(0, 0);
+        unittest::ExpectEqual(std::string, sourced.str(0, 2), "e");
+        unittest::ExpectEqual(std::size_t, sourced.garbage(), 0);
+        unittest::ExpectEqual(std::string, source, "a,\"b \"\"c\"\"\",d");
+
+        // The bytes grow slab by slab, a copy and compacting keep every cell
+        DenseMesh slabbed(64);
+        for (std::size_t index = 0; index < 100; ++index) {
+            slabbed.push_back({std::to_string(index), std::string(index % 70, 'x')});
+        }
+        unittest::ExpectTrue(slabbed.slabs() > 50);
+        slabbed.set(10, 1, std::string(200, 'y'));
+        const DenseMesh copy = slabbed;
+        slabbed.set(20, 0, "twenty");
+        slabbed.compact();
+        unittest::ExpectEqual(std::string, copy.str(10, 1), std::string(200, 'y'));
+        unittest::ExpectEqual(std::string, copy.str(20, 0), "20");
+        unittest::ExpectEqual(std::string, slabbed.str(20, 0), "twenty");
+        for (std::size_t index = 0; index < 100; ++index) {
+            if (index != 10) {
+                unittest::ExpectEqual(std::string, copy.str(index, 1), std::string(index % 70, 'x'));
+                unittest::ExpectEqual(std::string, slabbed.str(index, 1), std::string(index % 70, 'x'));
+            }
+        }
+
+        // Far less memory than a map per row
+        std::ifstream file(EXAMPLES_DIR "/msft.csv", std::ios::binary);
+        const std::string msft((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        auto reader = rapidcsv::read::rowReader(rapidcsv::read::blockReader(msft.begin(), msft.end()));
+        DenseMesh dense;
+        std::vector<std::unordered_map<std::size_t, std::string>> maps;
+        std::size_t mapMemory = 0;
+        while (reader->has_next()) {
+            const std::vector<std::string> cells = reader->next();
+            dense.push_back(cells);
+            std::unordered_map<std::size_t, std::string> map(cells.size());
+            for (std::size_t column = 0; column < cells.size(); ++column) {
+                map.emplace(column, cells[column]);
+            }
+            // A bucket pointer per bucket, a node per cell holding the key and a string
+            mapMemory += sizeof(map) + map.bucket_count() * sizeof(void *) +
+                         map.size() * (sizeof(void *) + sizeof(std::size_t) + sizeof(std::string));
+            maps.push_back(std::move(map));
+        }
+        dense.shrink_to_fit();
+        unittest::ExpectEqual(std::size_t, dense.size(), maps.size());
+        unittest::ExpectTrue(dense.memory() * 2 < mapMemory);
+        for (std::size_t index = 0; index < dense.size(); ++index) {
+            for (const auto &cell : maps[index]) {
+                unittest::ExpectEqual(std::string, dense.str(index, cell.first), cell.second);
+            }
+        }
+
+        // Rows past the end
+        bool thrown = false;
+        try {
+            dense.columns(dense.size());
+        } catch (const std::out_of_range &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
@@ -0,0 +1,191 @@
+// test069.cpp - column storage
+
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <detail/reader/row_reader.hpp>
+#include <detail/document/mesh.hpp>
+#include "unittest.h"
+
+using rapidcsv::StorageMode;
+using rapidcsv::doc::ColumnMesh;
+using rapidcsv::doc::DenseMesh;
+using rapidcsv::doc::Mesh;
+using rapidcsv::read::FieldView;
+
+// Both layouts hold the same cells
+bool same(const DenseMesh &rows, const ColumnMesh &columns) {
+    if (rows.size() != columns.size()) {
+        return false;
+    }
+    for (std::size_t row = 0; row < rows.size(); ++row) {
+        if (rows.row(row) != columns.row(row)) {
+            return false;
+        }
+        for (std::size_t column = 0; column < rows.columns(row); ++column) {
+            if (rows.has(row, column) != columns.has(row, column)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool sameColumn(const std::vector<FieldView> &lhs, const std::vector<FieldView> &rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (std::size_t cell = 0; cell < lhs.size(); ++cell) {
+        if (lhs[cell].str() != rhs[cell].str()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    int rv = 0;
+
+    try {
+        // Ragged rows, the cells of a column past the end of a row are absent
+        ColumnMesh mesh;
+        mesh.push_back({"Date", "Close", "Volume"});
+        mesh.push_back({"2017-02-24", "64.620003", "21705200"});
+        mesh.push_back({"2017-02-23"});
+        mesh.push_back({"2017-02-22", "64.360001", "19259700", "extra"});
+        unittest::ExpectEqual(std::size_t, mesh.size(), 4);
+        unittest::ExpectEqual(std::size_t, mesh.columns(2), 1);
+        unittest::ExpectEqual(std::size_t, mesh.columns(3), 4);
+        unittest::ExpectTrue(!mesh.has(2, 1) && !mesh.has(1, 3) && mesh.has(3, 3));
+        unittest::ExpectEqual(std::string, mesh.str(2, 2), "");
+        unittest::ExpectEqual(std::size_t, mesh.column(3).size(), 1);
+
+        // A whole column at once
+        const std::vector<FieldView> volumes = mesh.column(2, 1);
+        unittest::ExpectEqual(std::size_t, volumes.size(), 2);
+        unittest::ExpectEqual(std::string, volumes[1].str(), "19259700");
+        mesh.set_column(1, {"Open", "64.529999", "64.419998", "64.449997"});
+        unittest::ExpectEqual(std::size_t, mesh.columns(2), 2);
+        unittest::ExpectEqual(std::string, mesh.str(2, 1), "64.419998");
+        unittest::ExpectEqual(std::size_t, mesh.garbage(), 0);
+        mesh.erase_column(2);
+        unittest::ExpectTrue(mesh.column(2).empty());
+        unittest::ExpectEqual(std::size_t, mesh.columns(1), 3);
+        unittest::ExpectEqual(std::string, mesh.str(3, 3), "extra");
+
+        // Shorter rows than the column count given back whole
+        mesh.set_row(3, {"2017-02-21"});
+        unittest::ExpectEqual(std::size_t, mesh.columns(3), 1);
+        unittest::ExpectTrue(!mesh.has(3, 3));
+        unittest::ExpectTrue(mesh.row(3) == std::vector<std::string>({"2017-02-21"}));
+        mesh.erase_row(0);
+        unittest::ExpectEqual(std::size_t, mesh.size(), 3);
+        unittest::ExpectEqual(std::string, mesh.str(0, 1), "64.529999");
+
+        // The same edits on both layouts leave the same cells
+        std::mt19937 random(69);
+        std::uniform_int_distribution<int> pick(0, 99);
+        DenseMesh rows;
+        ColumnMesh columns;
+        for (int row = 0; row < 50; ++row) {
+            std::vector<std::string> cells(static_cast<std::size_t>(pick(random) % 6));
+            for (auto &cell : cells) {
+                cell = std::string(static_cast<std::size_t>(pick(random) % 12), static_cast<char>('a' + pick(random) % 26));
+            }
+            rows.push_back(cells);
+            columns.push_back(cells);
+        }
+        for (int edit = 0; edit < 2000; ++edit) {
+            const auto row = static_cast<std::size_t>(pick(random)) % rows.size();
+            const auto column = static_cast<std::size_t>(pick(random) % 7);
+            const std::string value(static_cast<std::size_t>(pick(random) % 16), static_cast<char>('A' + edit % 26));
+            switch (pick(random) % 10) {
+                case 0:
+                    rows.erase(row, column);
+                    columns.erase(row, column);
+                    break;
+                case 1:
+                    rows.set_row(row, std::vector<std::string>(column, value));
+                    columns.set_row(row, std::vector<std::string>(column, value));
+                    break;
+                case 2:
+                    if (edit % 50 == 0) {
+                        rows.erase_column(column);
+                        columns.erase_column(column);
+                    }
+                    break;
+                case 3:
+                    if (edit % 40 == 0) {
+                        const std::size_t firstRow = static_cast<std::size_t>(edit % 3);
+                        const std::vector<std::string> cells(edit % 80 == 0 ? rows.size() - firstRow : rows.size() / 2, value);
+                        rows.set_column(column, cells, firstRow);
+                        columns.set_column(column, cells, firstRow);
+                    }
+                    break;
+                case 4:
+                    if (rows.size() > 20) {
+                        rows.erase_row(row);
+                        columns.erase_row(row);
+                    }
+                    break;
+                default:
+                    rows.set(row, column, value);
+                    columns.set(row, column, value);
+            }
+            if (edit % 500 == 0) {
+                columns.compact();
+            }
+        }
+        unittest::ExpectTrue(same(rows, columns));
+        for (std::size_t column = 0; column < 8; ++column) {
+            unittest::ExpectTrue(sameColumn(rows.column(column, 1), columns.column(column, 1)));
+        }
+        columns.compact();
+        unittest::ExpectEqual(std::size_t, columns.garbage(), 0);
+        unittest::ExpectTrue(same(rows, columns));
+
+        // The layout is picked when loading, rows unless asked otherwise
+        unittest::ExpectTrue(rapidcsv::Properties().storageMode() == StorageMode::ROWS);
+        const rapidcsv::Properties properties = rapidcsv::PropertiesBuilder().storageMode(StorageMode::COLUMNS);
+        unittest::ExpectTrue(properties.storageMode() == StorageMode::COLUMNS);
+
+        std::ifstream file(EXAMPLES_DIR "/msft.csv", std::ios::binary);
+        const std::string msft((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        auto reader = rapidcsv::read::rowReader(rapidcsv::read::blockReader(msft.begin(), msft.end()));
+        Mesh byRows(StorageMode::ROWS), byColumns(properties.storageMode());
+        while (reader->has_next()) {
+            const std::vector<std::string> cells = reader->next();
+            byRows.push_back(cells);
+            byColumns.push_back(cells);
+        }
+        unittest::ExpectTrue(byColumns.mode() == StorageMode::COLUMNS);
+        unittest::ExpectEqual(std::size_t, byColumns.size(), byRows.size());
+        for (std::size_t column = 0; column < byRows.columns(0); ++column) {
+            unittest::ExpectTrue(sameColumn(byRows.column(column, 1), byColumns.column(column, 1)));
+        }
+        unittest::ExpectTrue(byRows.row(byRows.size() - 1) == byColumns.row(byColumns.size() - 1));
+        byColumns.erase_column(1);
+        byRows.erase_column(1);
+        unittest::ExpectTrue(byColumns.column(1).empty() && byRows.column(1).empty());
+        unittest::ExpectTrue(byRows.row(1) == byColumns.row(1));
+
+        bool thrown = false;
+        try {
+            byColumns.columns(byColumns.size());
+        } catch (const std::out_of_range &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    return rv;
+}
@@ -0,0 +1,226 @@
+// test070.cpp - load, edit and save whole documents
+
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#if !defined(_WIN32)
+#   include <sys/stat.h>
+#endif
+#include <rapidcsv.hpp>
+#include "unittest.h"
+
+using rapidcsv::LoadMode;
+using rapidcsv::PropertiesBuilder;
+using rapidcsv::StorageMode;
+using rapidcsv::doc::CSVDocument;
+using rapidcsv::doc::ColumnType;
+
+// Every row of a document, the same whichever way it was loaded
+std::vector<std::vector<std::string>> rows(const CSVDocument &document) {
+    std::vector<std::vector<std::string>> result;
+    for (std::size_t row = 0; row < document.size(); ++row) {
+        result.push_back(document.GetRow(row));
+    }
+    return result;
+}
+
+int main() {
+    int rv = 0;
+
+    std::string path = unittest::TempPath();
+    unittest::WriteFile(path,
+                        "-,Count,Price,Name\n"
+                        "a,300,1.5,\"x, y\"\n"
+                        "b,9999999999,2.25,\"say \"\"hi\"\"\"\n"
+                        "c,-7,,z\n");
+    const std::string msft = EXAMPLES_DIR "/msft.csv";
+
+    try {
+        // Header and row labels
+        CSVDocument document = rapidcsv::load(PropertiesBuilder().filePath(path).hasHeader().hasRowLabel());
+        unittest::ExpectEqual(std::size_t, document.size(), 3);
+        unittest::ExpectEqual(std::string, document.GetCell("b", "Price"), "2.25");
+        // Quoted fields keep their outer quotes, as the readers give them
+        unittest::ExpectEqual(std::string, document.GetCell(0, 2), "\"x, y\"");
+        unittest::ExpectEqual(std::string, document.GetColumnLabel(1), "Price");
+        unittest::ExpectEqual(std::string, document.GetRowLabel(2), "c");
+        unittest::ExpectEqual(int, document.GetCell<int>(2, 0), -7);
+        unittest::ExpectTrue(document.GetColumn("Price") == std::vector<std::string>({"1.5", "2.25", ""}));
+        unittest::ExpectTrue(document.GetRow("b") == std::vector<std::string>({"b", "9999999999", "2.25", "\"say \"hi\"\""}));
+        rapidcsv::convert::FailureBitmap failures;
+        unittest::ExpectTrue(document.GetColumn<double>("Price", failures) == std::vector<double>({1.5, 2.25, 0}));
+        unittest::ExpectEqual(std::size_t, failures.count(), 1);
+        unittest::ExpectTrue(document.schema().empty());
+
+        // Typed columns give the same cells, narrower types are clamped as convert_to_val() does
+        CSVDocument typed = rapidcsv::load(PropertiesBuilder().filePath(path).hasHeader().hasRowLabel().inferSchema());
+        unittest::ExpectTrue(typed.schema().type("Count") == ColumnType::INT64);
+        unittest::ExpectTrue(typed.schema().type("Price") == ColumnType::DOUBLE);
+        unittest::ExpectTrue(typed.schema().type("Name") == ColumnType::STRING);
+        unittest::ExpectTrue(rows(typed) == rows(document));
+        unittest::ExpectTrue(typed.GetColumn<std::int64_t>("Count") == std::vector<std::int64_t>({300, 9999999999, -7}));
+        unittest::ExpectTrue(typed.GetColumn<std::uint16_t>("Count") == std::vector<std::uint16_t>({300, 65535, 0}));
+        unittest::ExpectTrue(typed.GetColumn<int>(0) == std::vector<int>({300, INT_MAX, -7}));
+        unittest::ExpectTrue(typed.GetColumn<double>(0) == std::vector<double>({300, 9999999999, -7}));
+        unittest::ExpectTrue(typed.GetColumn<std::uint8_t>(0) == document.GetColumn<std::uint8_t>(0));
+        unittest::ExpectTrue(typed.GetColumn<std::uint64_t>(0) == document.GetColumn<std::uint64_t>(0));
+        unittest::ExpectTrue(typed.GetColumn<float>(1) == document.GetColumn<float>(1));
+
+        // Edits that don't fit the type move the column back to strings
+        typed.SetCell(0, 0, 301);
+        unittest::ExpectTrue(typed.schema().type("Count") == ColumnType::INT64);
+        typed.SetCell("c", "Count", std::string("n/a"));
+        unittest::ExpectTrue(typed.schema().type("Count") == ColumnType::STRING);
+        unittest::ExpectTrue(typed.GetColumn("Count") == std::vector<std::string>({"301", "9999999999", "n/a"}));
+
+        // Columns past the end of the rows grow them, removed rows move the others up
+        typed.SetColumn(3, std::vector<int>({1, 2, 3}));
+        unittest::ExpectEqual(std::size_t, typed.column_count("a"), 5);
+        unittest::ExpectEqual(std::string, typed.GetCell("c", "Name"), "z");
+        unittest::ExpectEqual(std::string, typed.GetCell(2, 3), "3");
+        const std::vector<std::string> removed = typed.RemoveRow("a");
+        unittest::ExpectEqual(std::string, removed[0], "a");
+        unittest::ExpectEqual(std::size_t, typed.size(), 2);
+        unittest::ExpectEqual(std::string, typed.GetRowLabel(0), "b");
+        unittest::ExpectEqual(std::string, typed.GetCell("c", "Count"), "n/a");
+        typed.RemoveColumn("Name");
+        unittest::ExpectTrue(typed.GetColumn(2, std::string("?")) == std::vector<std::string>({"?", "?"}));
+        unittest::ExpectTrue(typed.GetColumn("Price", std::string("?")) == std::vector<std::string>({"2.25", ""}));
+
+        bool thrown = false;
+        try {
+            typed.GetCell("b", "Name");
+        } catch (const std::out_of_range &) {
+            thrown = true;
+        }
+        unittest::ExpectTrue(thrown);
+
+        // Saved files read back the same, new cells are quoted when they need to be
+        const std::string saved = unittest::TempPath();
+        rapidcsv::save(document, saved);
+        unittest::ExpectEqual(std::string, unittest::ReadFile(saved), unittest::ReadFile(path));
+        CSVDocument reloaded = rapidcsv::load(PropertiesBuilder().filePath(saved).hasHeader().hasRowLabel());
+        unittest::ExpectTrue(rows(reloaded) == rows(document));
+        document.SetCell("c", "Name", std::string("1,\"2\""));
+        rapidcsv::save(document, saved);
+        const CSVDocument quoted = rapidcsv::load(PropertiesBuilder().filePath(saved).hasHeader().hasRowLabel());
+        unittest::ExpectEqual(std::string, quoted.GetCell("c", "Name"), "\"1,\"2\"\"");
+        unittest::DeleteFile(saved);
+
+        // Every way of reading the file gives the same document
+        const CSVDocument plain = rapidcsv::load(PropertiesBuilder().filePath(msft).hasHeader());
+        unittest::ExpectEqual(std::size_t, plain.size(), 7804);
+        unittest::ExpectEqual(std::string, plain.GetCell(0, 0), "2017-02-24");
+        const std::vector<rapidcsv::Properties> variants = {
+                PropertiesBuilder().filePath(msft).hasHeader().loadMode(LoadMode::MMAP),
+                PropertiesBuilder().filePath(msft).hasHeader().threads(4),
+                PropertiesBuilder().filePath(msft).hasHeader().threads(4).blockSize(4096),
+                PropertiesBuilder().filePath(msft).hasHeader().loadMode(LoadMode::MMAP).threads(4),
+                PropertiesBuilder().filePath(msft).hasHeader().prefetch().blockSize(4096),
+                PropertiesBuilder().filePath(msft).hasHeader().storageMode(StorageMode::COLUMNS),
+                PropertiesBuilder().filePath(msft).hasHeader().inferSchema(),
+        };
+        for (const auto &properties : variants) {
+            const CSVDocument loaded = rapidcsv::load(properties);
+            unittest::ExpectTrue(rows(loaded) == rows(plain));
+            unittest::ExpectTrue(loaded.GetColumn<std::int64_t>("Volume") == plain.GetColumn<std::int64_t>("Volume"));
+        }
+#if !defined(_WIN32)
+        // A pipe can't be mapped, a threaded STREAM load reads it on one thread
+        const std::string pipe = unittest::TempPath();
+        unittest::ExpectTrue(::mkfifo(pipe.c_str(), 0600) == 0);
+        std::thread writer([&pipe, &msft]() {
+            unittest::WriteFile(pipe, unittest::ReadFile(msft));
+        });
+        const CSVDocument piped = rapidcsv::load(PropertiesBuilder().filePath(pipe).hasHeader().threads(4));
+        writer.join();
+        unittest::DeleteFile(pipe);
+        unittest::ExpectTrue(rows(piped) == rows(plain));
+#endif
+        const auto lazy = rapidcsv::load_lazy(variants.front());
+        unittest::ExpectEqual(std::size_t, lazy->size(), plain.size());
+        unittest::ExpectTrue(lazy->GetRow(7803) == plain.GetRow(7803));
+        unittest::ExpectTrue(lazy->GetColumn<double>("Close") == plain.GetColumn<double>("Close"));
+        const CSVDocument inferred = rapidcsv::load(variants.back());
+        unittest::ExpectTrue(inferred.schema().type("Date") == ColumnType::DATE);
+        unittest::ExpectTrue(inferred.schema().type("Volume") == ColumnType::INT64);
+        unittest::ExpectTrue(inferred.schema().type("Close") == ColumnType::DOUBLE);
+        unittest::ExpectTrue(rows(inferred) == rows(plain));
+        unittest::ExpectTrue(!rapidcsv::load(variants.front()).mapping());
+        const CSVDocument mapped = rapidcsv::load(PropertiesBuilder().filePath(msft).hasHeader()
+                                                          .loadMode(LoadMode::MMAP).keepMapping());
+        unittest::ExpectEqual(std::size_t, mapped.mapping()->size(), unittest::ReadFile(msft).size());
+        unittest::ExpectTrue(rows(mapped) == rows(plain));
+
+        // Cells refer to a kept mapping until edited, saving over the mapped file leaves them valid
+        const auto original = rows(rapidcsv::load(PropertiesBuilder().filePath(path).hasHeader().hasRowLabel()));
+        for (const StorageMode storage : {StorageMode::ROWS, StorageMode::COLUMNS}) {
+            const std::string kept = unittest::TempPath();
+            unittest::WriteFile(kept, unittest::ReadFile(path));
+            CSVDocument edited = rapidcsv::load(PropertiesBuilder().filePath(kept).hasHeader().hasRowLabel()
+                                                        .storageMode(storage).loadMode(LoadMode::MMAP).keepMapping());
+            unittest::ExpectTrue(rows(edited) == original);
+            edited.SetCell("a", "Count", std::string("3"));
+            edited.SetCell("b", "Name", std::string("w"));
+            const CSVDocument copy = edited;
+            rapidcsv::save(edited);
+            unittest::ExpectEqual(std::string, edited.GetCell("a", "Count"), "3");
+            unittest::ExpectEqual(std::string, edited.GetCell("c", "Name"), "z");
+            unittest::ExpectEqual(std::string, edited.GetCell(0, 2), "\"x, y\"");
+            unittest::ExpectTrue(rows(copy) == rows(edited));
+            const CSVDocument back = rapidcsv::load(PropertiesBuilder().filePath(kept).hasHeader().hasRowLabel());
+            unittest::ExpectTrue(rows(back) == rows(edited));
+            unittest::DeleteFile(kept);
+        }
+
+        // Only the kept columns and rows are stored
+        const CSVDocument narrow = rapidcsv::load(PropertiesBuilder().filePath(msft).hasHeader()
+                                                          .keepColumnNames({"Date", "Volume"})
+                                                          .filterRows(0, [](const rapidcsv::read::FieldView &date) {
+                                                              return date.str().compare(0, 4, "2017") == 0;
+                                                          }));
+        unittest::ExpectEqual(std::size_t, narrow.size(), 37);
+        unittest::ExpectTrue(narrow.GetRow(0) == std::vector<std::string>({"2017-02-24", "21705200"}));
+        unittest::ExpectEqual(std::int64_t, narrow.GetColumn<std::int64_t>("Volume").back(), 20694100);
+
+        // Malformed rows are dropped and recorded
+        const std::string broken = unittest::TempPath();
+        unittest::WriteFile(broken, "A,B\n1,2\n3,x\"y\n5,6\n");
+        const CSVDocument collected = rapidcsv::load(PropertiesBuilder().filePath(broken).hasHeader()
+                                                             .errorPolicy(rapidcsv::ErrorPolicy::COLLECT));
+        unittest::ExpectEqual(std::size_t, collected.size(), 2);
+        unittest::ExpectEqual(std::size_t, collected.diagnostics().size(), 1);
+        unittest::ExpectEqual(std::string, collected.GetCell(1, 0), "5");
+        unittest::DeleteFile(broken);
+
+        // Other separators and quotes, on one thread or several
+        const std::string semicolons = unittest::TempPath();
+        unittest::WriteFile(semicolons, "A;B\r\n1;'x;y'\r\n2;z\r\n");
+        for (std::size_t threads = 1; threads <= 2; ++threads) {
+            const CSVDocument dialect = rapidcsv::load(PropertiesBuilder().filePath(semicolons).hasHeader()
+                                                               .fieldSep(';').quote('\'')
+                                                               .rowSep(rapidcsv::RowSepType::CRLF).threads(threads));
+            unittest::ExpectEqual(std::size_t, dialect.size(), 2);
+            unittest::ExpectEqual(std::string, dialect.GetCell(0, 1), "'x;y'");
+            unittest::ExpectEqual(std::string, dialect.GetCell(1, 1), "z");
+        }
+        unittest::DeleteFile(semicolons);
+
+        // Counting without storing
+        const rapidcsv::read::ScanStats stats = rapidcsv::scan_stats(msft);
+        unittest::ExpectEqual(std::uint64_t, stats.rows, 7805);
+        unittest::ExpectEqual(std::size_t, stats.maxFields(), 7);
+    }
+    catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        rv = 1;
+    }
+
+    unittest::DeleteFile(path);
+
+    return rv;
+}